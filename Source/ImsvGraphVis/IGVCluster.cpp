@@ -14,6 +14,7 @@ FIGVCluster::FIGVCluster(AIGVGraphActor* const InGraphActor)
 	  Height(-1),
 	  Pos2D(FVector2D::ZeroVector),
 	  Pos3D(FVector::ZeroVector),
+	  TreemapRect(ForceInit),
 	  Parent(nullptr),
 	  Children(),
 	  Node(nullptr),
@@ -45,6 +46,19 @@ void FIGVCluster::SetNumDescendantNodes()
 	});
 }
 
+FIGVCluster* FIGVCluster::CommonAncestor(FIGVCluster* A, FIGVCluster* B)
+{
+	while (A->Height < B->Height) A = A->Parent;
+	while (B->Height < A->Height) B = B->Parent;
+
+	while (A != B)
+	{
+		A = A->Parent;
+		B = B->Parent;
+	}
+	return A;
+}
+
 bool FIGVCluster::IsRoot() const
 {
 	return ParentIdx == -1;
@@ -84,6 +98,11 @@ void FIGVCluster::SetPosNonLeaf()
 }
 
 float FIGVCluster::DefaultLevel() const
+{
+	return DefaultLevel(GraphActor, Height);
+}
+
+float FIGVCluster::DefaultLevel(AIGVGraphActor const* const GraphActor, int32 const Height)
 {
 	return (1 + GraphActor->ClusterLevelOffset) +
 		   GraphActor->ClusterLevelScale * FMath::Pow(Height - 1, GraphActor->ClusterLevelExponent);
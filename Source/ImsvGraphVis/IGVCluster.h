@@ -32,6 +32,8 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = ImmersiveGraphVisualization)
 	FVector Pos3D;
 
+	FBox2D TreemapRect;  // Before normalization, see FIGVTreemapLayout::ComputeSubtree
+
 	FIGVCluster* Parent;
 	TArray<FIGVCluster*> Children;
 	class AIGVNodeActor* Node;
@@ -65,6 +67,8 @@ public:
 
 	void SetNumDescendantNodes();
 
+	static FIGVCluster* CommonAncestor(FIGVCluster* A, FIGVCluster* B);
+
 	bool IsRoot() const;
 	bool IsLeaf() const;
 
@@ -72,4 +76,5 @@ public:
 	void SetPosNonLeaf();
 
 	float DefaultLevel() const;
+	static float DefaultLevel(class AIGVGraphActor const* const GraphActor, int32 const Height);
 };
@@ -0,0 +1,90 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVClusterLCA.h"
+
+#include "IGVCluster.h"
+
+FIGVClusterLCA::FIGVClusterLCA()
+	: Clusters(nullptr), Depths(), FirstEulerIdxs(), SparseTable(), EulerLength(0)
+{
+}
+
+void FIGVClusterLCA::Build(TArray<FIGVCluster>& InClusters, FIGVCluster const& Root)
+{
+	Clusters = &InClusters;
+
+	int32 const NumClusters = InClusters.Num();
+	Depths.Init(0, NumClusters);
+	FirstEulerIdxs.Init(INDEX_NONE, NumClusters);
+
+	// Iterative Euler tour of the non-leaf clusters; leaves only get their depth
+	TArray<int32> Tour;
+	Tour.Reserve(2 * NumClusters);
+
+	TArray<TPair<FIGVCluster const*, int32>> Stack;  // Cluster and its next child
+	Stack.Emplace(&Root, 0);
+	FirstEulerIdxs[Root.Idx] = 0;
+	Tour.Add(Root.Idx);
+
+	while (Stack.Num() > 0)
+	{
+		FIGVCluster const* const Cluster = Stack.Last().Key;
+		int32& ChildIdx = Stack.Last().Value;
+
+		if (ChildIdx == Cluster->Children.Num())
+		{
+			Stack.Pop(false);
+			if (Stack.Num() > 0)
+			{
+				Tour.Add(Stack.Last().Key->Idx);
+			}
+			continue;
+		}
+
+		FIGVCluster const* const Child = Cluster->Children[ChildIdx++];
+		Depths[Child->Idx] = Depths[Cluster->Idx] + 1;
+
+		if (!Child->IsLeaf())
+		{
+			FirstEulerIdxs[Child->Idx] = Tour.Num();
+			Tour.Add(Child->Idx);
+			Stack.Emplace(Child, 0);
+		}
+	}
+
+	// Sparse table of the shallowest cluster over every power of two range of the tour
+	EulerLength = Tour.Num();
+	int32 const NumLevels = FMath::FloorLog2(EulerLength) + 1;
+
+	SparseTable.SetNumUninitialized(NumLevels * EulerLength);
+	FMemory::Memcpy(SparseTable.GetData(), Tour.GetData(), sizeof(int32) * EulerLength);
+
+	for (int32 Level = 1; Level < NumLevels; Level++)
+	{
+		int32 const* const Prev = SparseTable.GetData() + (Level - 1) * EulerLength;
+		int32* const Curr = SparseTable.GetData() + Level * EulerLength;
+		int32 const HalfSpan = 1 << (Level - 1);
+
+		for (int32 Idx = 0; Idx + 2 * HalfSpan <= EulerLength; Idx++)
+		{
+			Curr[Idx] = MinDepthCluster(Prev[Idx], Prev[Idx + HalfSpan]);
+		}
+	}
+}
+
+FIGVCluster* FIGVClusterLCA::Find(FIGVCluster const& A, FIGVCluster const& B) const
+{
+	int32 First = FirstEulerIdxs[A.Idx];
+	int32 Last = FirstEulerIdxs[B.Idx];
+	check(First != INDEX_NONE && Last != INDEX_NONE);
+
+	if (First > Last)
+	{
+		Swap(First, Last);
+	}
+
+	int32 const Level = FMath::FloorLog2(Last - First + 1);
+	int32 const* const Row = SparseTable.GetData() + Level * EulerLength;
+
+	return &(*Clusters)[MinDepthCluster(Row[First], Row[Last - (1 << Level) + 1])];
+}
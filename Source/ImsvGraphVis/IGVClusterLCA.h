@@ -0,0 +1,42 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FIGVCluster;
+
+// Constant time lowest common ancestor queries on the clustering hierarchy: an Euler tour of the
+// hierarchy with a sparse table of minimum depths over it. Only non-leaf clusters are toured, since
+// the lowest common ancestor of two leaves is that of their parents. Queries are read-only and can
+// run from any thread; the structure must be rebuilt once the hierarchy changes.
+class IMSVGRAPHVIS_API FIGVClusterLCA
+{
+public:
+	FIGVClusterLCA();
+
+	void Build(TArray<FIGVCluster>& InClusters, FIGVCluster const& Root);
+
+	// Both clusters must be non-leaf clusters
+	FIGVCluster* Find(FIGVCluster const& A, FIGVCluster const& B) const;
+
+	FORCEINLINE int32 GetDepth(int32 const ClusterIdx) const
+	{
+		return Depths[ClusterIdx];
+	}
+
+private:
+	FORCEINLINE int32 MinDepthCluster(int32 const ClusterIdxA, int32 const ClusterIdxB) const
+	{
+		return Depths[ClusterIdxA] <= Depths[ClusterIdxB] ? ClusterIdxA : ClusterIdxB;
+	}
+
+	TArray<FIGVCluster>* Clusters;
+
+	TArray<int32> Depths;		   // Per cluster, 0 for the root
+	TArray<int32> FirstEulerIdxs;  // Per cluster, INDEX_NONE for leaves
+
+	// Level k holds the shallowest cluster of the 2^k tour entries starting at each position
+	TArray<int32> SparseTable;
+	int32 EulerLength;
+};
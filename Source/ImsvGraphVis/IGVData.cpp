@@ -149,13 +149,14 @@ void UIGVData::DeserializeEdges(TArray<TSharedPtr<FJsonValue>> const& EdgeJsonOb
 	{
 		TSharedPtr<FJsonObject> const EdgeJsonObj = JsonVal->AsObject();
 
-		GraphActor->Edges.Emplace(GraphActor);
-		FIGVEdge& Edge = GraphActor->Edges.Last();
+		FIGVEdge Edge;
 
 		if (!JsonObjectToUStruct(EdgeJsonObj.ToSharedRef(), &Edge))
 		{
 			IGV_LOG_S(Error, TEXT("Unable to deserialize an edge"));
 		}
+
+		GraphActor->Edges.Add(MoveTemp(Edge));
 	}
 }
 
@@ -11,13 +11,16 @@
 
 #include "IGVEdge.generated.h"
 
+// Edge record of FIGVEdgeStore. The cluster path, its levels and the spline control points live in
+// pooled arrays of the store; the edge only keeps offsets and lengths into them.
 USTRUCT()
 struct IMSVGRAPHVIS_API FIGVEdge
 {
 	GENERATED_BODY()
 
 public:
-	class AIGVGraphActor* GraphActor;
+	// Slot in AIGVGraphActor::Edges, assigned by FIGVEdgeStore::Add
+	int32 StoreSlotIdx;
 
 	UPROPERTY(VisibleAnywhere, SaveGame, Category = ImmersiveGraphVisualization)
 	int32 SourceIdx;
@@ -29,14 +32,17 @@ public:
 	class AIGVNodeActor* TargetNode;
 
 	struct FIGVCluster* LowestCommonAncestor;
-	TArray<struct FIGVCluster*> Clusters;
 	int32 LowestCommonAncestorIdxInClusters;
 
-	TArray<float> ClusterLevels;
-	TArray<float> ClusterLevelsDefault;
-	TArray<float> ClusterLevelsBeforeTransition;
-	TArray<float> ClusterLevelsAfterTransition;
-	TArray<FIGVEdgeSplineControlPointData> SplineControlPointData;
+	// Clusters, ClusterLevels, ClusterLevelsDefault, ClusterLevelsBeforeTransition,
+	// ClusterLevelsAfterTransition and the control point references share
+	// [PathOffset, PathOffset + PathLength)
+	int32 PathOffset;
+	int32 PathLength;
+	int32 PathCapacity;
+
+	int32 NumControlPoints;  // Including the source and target node
+
 	FIGVEdgeMeshData MeshData;
 
 	EIGVEdgeRenderGroup::Type RenderGroup;
@@ -44,41 +50,10 @@ public:
 	bool bUpdateMeshRequired;
 
 public:
-	FIGVEdge() = default;
-	FIGVEdge(class AIGVGraphActor* const InGraphActor);
+	FIGVEdge();
 
 	FString ToString() const;
 
-	void SetupClusters();
-
-public:
-	void UpdateDefaultClusterLevels();
-
-	void UpdateSplineControlPoints();
-	void UpdateDefaultSplineControlPoints();
-
-protected:
-	void UpdateSplineControlPointsImpl(TArray<float> const& InClusterLevels,
-									   float const SourceLevelScale, float const TargetLevelScale);
-
-public:
-	float BundlingStrength() const;
-
-	bool HasHighlightedNode() const;
-	bool HasNeighborHighlightedNode() const;
-	bool HasBothHighlightedNodes() const;
-
-	bool IsDefaultRenderGroup() const;
-	bool IsHighlightedRenderGroup() const;
-	bool IsRemainedRenderGroup() const;
-	bool IsHiddenRenderGroup() const;  //DPK
-	void UpdateRenderGroup();
-
-	void BeginTransition();
-	void OnHighlightTransitionTimelineUpdate(ETimelineDirection::Type const Direction,
-											 float const Alpha);
-	void OnHighlightTransitionTimelineFinished(ETimelineDirection::Type const Direction);
-
 	bool operator==(const FIGVEdge A) const;
 	bool operator==(FIGVEdge A);
 };
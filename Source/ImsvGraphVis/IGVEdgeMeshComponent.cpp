@@ -3,11 +3,14 @@
 
 #include "IGVEdgeMeshComponent.h"
 
+#include "Algo/BinarySearch.h"
+
 #include "KWColorSpace.h"
 #include "KWTask.h"
 
 #include "IGVEdge.h"
 #include "IGVEdgeMeshSceneProxy.h"
+#include "IGVEdgeMeshTessellator.h"
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
 #include "IGVNodeActor.h"
@@ -27,6 +30,26 @@ UMaterialInterface* GetTranslucentEdgeMaterial()
 	return MaterialAsset.Succeeded() ? MaterialAsset.Object->GetMaterial() : nullptr;
 }
 
+// Appends the runs of set bits, extending the last range if a run continues it
+static bool AddSetBitRanges(TBitArray<> const& Bits, TArray<FIGVEdgeMeshRange>& OutRanges)
+{
+	bool bAdded = false;
+	for (TConstSetBitIterator<> It(Bits); It; ++It)
+	{
+		int32 const Idx = It.GetIndex();
+		if (OutRanges.Num() > 0 && OutRanges.Last().End == Idx)
+		{
+			OutRanges.Last().End++;
+		}
+		else
+		{
+			OutRanges.Add(FIGVEdgeMeshRange{Idx, Idx + 1});
+		}
+		bAdded = true;
+	}
+	return bAdded;
+}
+
 UIGVEdgeMeshComponent::UIGVEdgeMeshComponent()
 	: GraphActor(nullptr),
 	  RenderGroup(EIGVEdgeRenderGroup::Default),
@@ -36,6 +59,36 @@ UIGVEdgeMeshComponent::UIGVEdgeMeshComponent()
 	  NumMeshVertices(0),
 	  NumMeshIndices(0),
 	  MeshIndices(),
+	  SplineEdgeSlotIdxs(),
+	  EdgeSlotSplineIdxs(),
+	  SplineBeginSegmentIdxs(),
+	  NumEdgeSplines(0),
+	  LayoutNumSides(0),
+	  LayoutNumSegmentSamples(0),
+	  bLayoutUsesIndexTemplate(false),
+	  DirtySplineRanges(),
+	  FreeSplineIdxs(),
+	  SegmentSlotIdxs(),
+	  SlotSegmentIdxs(),
+	  SplineRenderGroups(),
+	  DrawSlotRange{0, 0},
+	  bDrawSlotRangeChanged(false),
+	  ChunkBounds(),
+	  LocalBounds(ForceInit),
+	  bChunkBoundsChanged(false),
+	  BoundsDirtyChunks(),
+	  SegmentCurvatures(),
+	  SegmentSampleLODs(),
+	  ChunkLODs(),
+	  SlotLODs(),
+	  bSlotLODsChanged(false),
+	  SlotLODDirtyChunks(),
+	  SampleTolerance(0.f),
+	  NumSampledVertices(0),
+	  bRenderStateDirty(false),
+	  bRenderDynamicDataDirty(false),
+	  bBoundsDirty(false),
+	  FlushedLocalBounds(ForceInit),
 	  MaterialInstance(nullptr)
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -43,6 +96,8 @@ UIGVEdgeMeshComponent::UIGVEdgeMeshComponent()
 
 	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
 
+	FMemory::Memzero(GroupBeginSlotIdxs);
+
 	GetEdgeMaterial();
 	GetTranslucentEdgeMaterial(); //DPK
 }
@@ -69,173 +124,1050 @@ void UIGVEdgeMeshComponent::Setup()
 		SetHalo(true);
 	}
 
-	Update();
+	Rebuild();
+}
+
+void UIGVEdgeMeshComponent::Update()
+{
+	UpdateImpl(false);
 }
 
-int32 GetVertexIdx(int32 const NumSides, int32 const AlongIdx, int32 const AroundIdx)
+void UIGVEdgeMeshComponent::UpdateDirtyEdges()
 {
-	return (AlongIdx * NumSides) + (AroundIdx % NumSides);
+	UpdateImpl(true);
 }
 
-void UIGVEdgeMeshComponent::Update()
+void UIGVEdgeMeshComponent::UpdateDrawRanges()
+{
+	if (!IsLayoutUpToDate())
+	{
+		Rebuild();
+		return;
+	}
+
+	TBitArray<> DirtySplines(false, SplineData.Num());
+
+	for (FIGVEdge const& Edge : GraphActor->Edges)
+	{
+		if (!IsInGroup(Edge)) continue;
+
+		int32 const SplineIdx = FindSpline(Edge);
+		if (SplineRenderGroups[SplineIdx].GetValue() != Edge.RenderGroup)
+		{
+			MoveSpline(SplineIdx, Edge.RenderGroup, DirtySplines);
+		}
+	}
+
+	// Moved segments are tessellated again at their new slots, once their chunks are in order
+	SortChunks(DirtySplines);
+	bool const bDirty = AddDirtySplines(DirtySplines);
+
+	UpdateDrawSlotRange();
+
+	if (bDirty || bDrawSlotRangeChanged)
+	{
+		UpdateChunkBounds(DirtySplineRanges);
+		bRenderDynamicDataDirty = true;
+	}
+}
+
+void UIGVEdgeMeshComponent::UpdateChangedEdges(TArray<FIGVEdge*> const& ChangedEdges)
+{
+	TBitArray<> DirtySplines(false, SplineData.Num());
+	TArray<TPair<int32, FIGVEdge*>> Splines;
+	if (!AllocateSplines(ChangedEdges, DirtySplines, Splines))
+	{
+		IGV_LOG(Log, TEXT("No spare edge spline left, rebuilding the edge mesh"));
+		Rebuild();
+		return;
+	}
+
+	// Only the splines that were written or resized, or whose segments changed slots
+	UpdateSplines(Splines);
+
+	TArray<FIGVEdgeMeshRange> SplineRanges;
+	AddSetBitRanges(DirtySplines, SplineRanges);
+	UpdateSampleLODs(SplineRanges, false);
+
+	SortChunks(DirtySplines);
+	AddDirtySplines(DirtySplines);
+
+	UpdateDrawSlotRange();
+	UpdateChunkBounds(DirtySplineRanges);
+	bRenderDynamicDataDirty = true;
+}
+
+bool UIGVEdgeMeshComponent::AllocateSplines(TArray<FIGVEdge*> const& ChangedEdges,
+											TBitArray<>& DirtySplines,
+											TArray<TPair<int32, FIGVEdge*>>& OutSplines)
+{
+	if (!IsTessellationUpToDate()) return false;
+
+	// Splines of removed edges, or of edges that left the group, are freed first
+	TBitArray<> LiveSplines(false, SplineData.Num());
+	TArray<FIGVEdge*> NewEdges;
+	for (FIGVEdge& Edge : GraphActor->Edges)
+	{
+		if (!IsInGroup(Edge)) continue;
+
+		int32 const SplineIdx = FindSpline(Edge);
+		if (SplineIdx == INDEX_NONE)
+		{
+			NewEdges.Add(&Edge);
+			continue;
+		}
+
+		LiveSplines[SplineIdx] = true;
+		if (SplineRenderGroups[SplineIdx].GetValue() != Edge.RenderGroup)
+		{
+			MoveSpline(SplineIdx, Edge.RenderGroup, DirtySplines);
+		}
+	}
+	for (int32 SplineIdx = 0; SplineIdx < SplineData.Num(); SplineIdx++)
+	{
+		if (SplineEdgeSlotIdxs[SplineIdx] != INDEX_NONE && !LiveSplines[SplineIdx])
+		{
+			FreeSpline(SplineIdx, DirtySplines);
+		}
+	}
+
+	// Changed edges keep their spline while their segments fit in it
+	for (FIGVEdge* const Edge : ChangedEdges)
+	{
+		if (!IsInGroup(*Edge)) continue;
+
+		int32 const SplineIdx = FindSpline(*Edge);
+		if (SplineIdx == INDEX_NONE) continue;  // Already among the new edges
+
+		int32 const NumSegments = Edge->NumControlPoints + 1;
+		if (NumSegments > GetSplineEndSegmentIdx(SplineIdx) - SplineBeginSegmentIdxs[SplineIdx])
+		{
+			FreeSpline(SplineIdx, DirtySplines);
+			NewEdges.Add(Edge);
+			continue;
+		}
+
+		ResizeSpline(SplineIdx, NumSegments, DirtySplines);
+		OutSplines.Emplace(SplineIdx, Edge);
+	}
+
+	for (FIGVEdge* const Edge : NewEdges)
+	{
+		int32 const NumSegments = Edge->NumControlPoints + 1;
+		int32 const FreeIdx = FreeSplineIdxs.IndexOfByPredicate([&](int32 const SplineIdx) {
+			return GetSplineEndSegmentIdx(SplineIdx) - SplineBeginSegmentIdxs[SplineIdx] >=
+				   NumSegments;
+		});
+		if (FreeIdx == INDEX_NONE) return false;
+
+		int32 const SplineIdx = FreeSplineIdxs[FreeIdx];
+		FreeSplineIdxs.RemoveAtSwap(FreeIdx);
+
+		SplineRenderGroups[SplineIdx] = Edge->RenderGroup;
+		ResizeSpline(SplineIdx, NumSegments, DirtySplines);
+
+		SetSplineEdgeSlot(SplineIdx, Edge->StoreSlotIdx);
+		OutSplines.Emplace(SplineIdx, Edge);
+	}
+	return true;
+}
+
+void UIGVEdgeMeshComponent::UpdateLOD(FVector const& ViewLocation, FVector const& ViewDirection)
+{
+	// Template mode only: a full index buffer has one fixed tessellation per slot
+	if (!bLayoutUsesIndexTemplate) return;
+
+	TBitArray<> DirtySplines(false, SplineData.Num());
+	bool bChanged = false;
+
+	for (int32 ChunkIdx = 0; ChunkIdx < ChunkLODs.Num(); ChunkIdx++)
+	{
+		uint8 const LOD = GraphActor->bEdgeLOD
+							  ? CalcChunkLOD(ChunkIdx, ViewLocation, ViewDirection)
+							  : 0;
+		if (LOD == ChunkLODs[ChunkIdx]) continue;
+
+		ChunkLODs[ChunkIdx] = LOD;
+		bChanged = true;
+
+		int32 const BeginSlotIdx = ChunkIdx * NumChunkSlots;
+		int32 const EndSlotIdx = FMath::Min(BeginSlotIdx + NumChunkSlots, SlotSegmentIdxs.Num());
+		for (int32 SlotIdx = BeginSlotIdx; SlotIdx < EndSlotIdx; SlotIdx++)
+		{
+			int32 const SegmentIdx = SlotSegmentIdxs[SlotIdx];
+			SetSegmentSlot(SegmentIdx, SlotIdx);  // Picks up the samples of the new level
+			DirtySplines[SplineSegmentData[SegmentIdx].SplineIdx] = true;
+		}
+	}
+
+	if (bChanged)
+	{
+		AddDirtySplines(DirtySplines);
+		bRenderDynamicDataDirty = true;
+	}
+}
+
+uint8 UIGVEdgeMeshComponent::CalcChunkLOD(int32 const ChunkIdx, FVector const& ViewLocation,
+										  FVector const& ViewDirection) const
+{
+	FBox const& LocalChunkBounds = ChunkBounds[ChunkIdx];
+	if (!LocalChunkBounds.IsValid) return 0;
+
+	FBox const Bounds = LocalChunkBounds.TransformBy(GetComponentTransform());
+	FVector const ToChunk = Bounds.GetCenter() - ViewLocation;
+	float const Distance = ToChunk.Size();
+	float const Radius = Bounds.GetExtent().Size();
+	if (Distance <= Radius) return 0;
+
+	// Angle between the gaze and the nearest point of the chunk, and the angle the chunk spans
+	float const HalfAngularSize = FMath::RadiansToDegrees(FMath::Asin(Radius / Distance));
+	float const Angle = FMath::RadiansToDegrees(FMath::Acos(
+							FMath::Clamp(FVector::DotProduct(ToChunk / Distance, ViewDirection),
+										 -1.f, 1.f))) -
+						HalfAngularSize;
+
+	float const AngleScale = GraphActor->FrameGovernor.GetLODAngleScale();
+	int32 LOD = Angle > GraphActor->EdgeLODPeripheryAngle * AngleScale
+					? 2
+					: Angle > GraphActor->EdgeLODFoveaAngle * AngleScale ? 1 : 0;
+	if (2 * HalfAngularSize < GraphActor->EdgeLODMinAngularSize) LOD++;
+
+	return FMath::Min(LOD, NumLODs - 1);
+}
+
+void UIGVEdgeMeshComponent::UpdateSampling()
+{
+	if (!IsLayoutUpToDate())
+	{
+		Rebuild();
+		return;
+	}
+
+	// Curvatures are unchanged, only the fitted levels
+	int32 const NumDirtySplineRanges = DirtySplineRanges.Num();
+	UpdateSampleLODs(TArray<FIGVEdgeMeshRange>(), true);
+
+	if (DirtySplineRanges.Num() != NumDirtySplineRanges || bSlotLODsChanged)
+	{
+		bRenderDynamicDataDirty = true;
+	}
+}
+
+bool UIGVEdgeMeshComponent::IsInGroup(FIGVEdge const& Edge) const
+{
+	return RenderGroup == EIGVEdgeRenderGroup::Default || Edge.RenderGroup == RenderGroup;
+}
+
+bool UIGVEdgeMeshComponent::UsesIndexTemplate() const
+{
+	// Every segment has to be addressable with 16-bit indices
+	return GraphActor->bEdgeIndexTemplate &&
+		   GraphActor->EdgeNumSides * GraphActor->EdgeSplineResolution <= MAX_uint16 + 1;
+}
+
+bool UIGVEdgeMeshComponent::IsTessellationUpToDate() const
+{
+	return LayoutNumSides == GraphActor->EdgeNumSides &&
+		   LayoutNumSegmentSamples == GraphActor->EdgeSplineResolution &&
+		   bLayoutUsesIndexTemplate == UsesIndexTemplate();
+}
+
+bool UIGVEdgeMeshComponent::IsLayoutUpToDate() const
+{
+	if (!IsTessellationUpToDate()) return false;
+
+	int32 NumEdges = 0;
+	for (FIGVEdge const& Edge : GraphActor->Edges)
+	{
+		if (!IsInGroup(Edge)) continue;
+
+		int32 const SplineIdx = FindSpline(Edge);
+		if (SplineIdx == INDEX_NONE ||
+			SplineData[SplineIdx].NumControlPoints != uint32(Edge.NumControlPoints + 4))
+		{
+			return false;
+		}
+		NumEdges++;
+	}
+	return NumEdges == NumEdgeSplines;
+}
+
+int32 UIGVEdgeMeshComponent::FindSpline(FIGVEdge const& Edge) const
+{
+	return EdgeSlotSplineIdxs.IsValidIndex(Edge.StoreSlotIdx)
+			   ? EdgeSlotSplineIdxs[Edge.StoreSlotIdx]
+			   : INDEX_NONE;
+}
+
+int32 UIGVEdgeMeshComponent::GetSplineEndSegmentIdx(int32 const SplineIdx) const
+{
+	return SplineIdx + 1 < SplineBeginSegmentIdxs.Num() ? SplineBeginSegmentIdxs[SplineIdx + 1]
+														: SplineSegmentData.Num();
+}
+
+void UIGVEdgeMeshComponent::UpdateImpl(bool const bOnlyDirtyEdges)
+{
+	if (!IsLayoutUpToDate())
+	{
+		Rebuild();
+		return;
+	}
+
+	// Same splines in the same places: rewrite the dirty ones and let the proxy patch its buffers
+	TArray<TPair<int32, FIGVEdge*>> Splines;
+	TBitArray<> UpdatedSplines(false, SplineData.Num());
+
+	for (FIGVEdge& Edge : GraphActor->Edges)
+	{
+		if (!IsInGroup(Edge)) continue;
+
+		if (!bOnlyDirtyEdges || Edge.bUpdateMeshRequired)
+		{
+			int32 const SplineIdx = FindSpline(Edge);
+			Splines.Emplace(SplineIdx, &Edge);
+			UpdatedSplines[SplineIdx] = true;
+		}
+	}
+
+	if (Splines.Num() > 0)
+	{
+		// Appended to the ranges not yet consumed by the scene proxy
+		TArray<FIGVEdgeMeshRange> SplineRanges;  // Of this update only
+		AddSetBitRanges(UpdatedSplines, SplineRanges);
+		AddDirtySplines(UpdatedSplines);
+
+		UpdateSplines(Splines);
+		UpdateSampleLODs(SplineRanges, false);
+		UpdateChunkBounds(DirtySplineRanges);
+		bRenderDynamicDataDirty = true;
+	}
+}
+
+void UIGVEdgeMeshComponent::Rebuild()
 {
 	SplineControlPointData.Reset();
 	SplineSegmentData.Reset();
 	SplineData.Reset();
 	MeshIndices.Reset();
+	SplineEdgeSlotIdxs.Reset();
+	EdgeSlotSplineIdxs.Reset();
+	SplineBeginSegmentIdxs.Reset();
+	NumEdgeSplines = 0;
+	DirtySplineRanges.Reset();
+	FreeSplineIdxs.Reset();
+	SegmentSlotIdxs.Reset();
+	SlotSegmentIdxs.Reset();
+	SplineRenderGroups.Reset();
+	bDrawSlotRangeChanged = false;
+	ChunkBounds.Reset();
+	SegmentCurvatures.Reset();
+	SegmentSampleLODs.Reset();
+	ChunkLODs.Reset();
+	SlotLODs.Reset();
+	LocalBounds = FBox(ForceInit);
 
 	NumMeshVertices = 0;
 	NumMeshIndices = 0;
 
 	uint32 const NumSides = GraphActor->EdgeNumSides;
 	uint32 const NumSegmentSamples = GraphActor->EdgeSplineResolution;
+	LayoutNumSides = NumSides;
+	LayoutNumSegmentSamples = NumSegmentSamples;
+	bLayoutUsesIndexTemplate = UsesIndexTemplate();
 
-	for (FIGVEdge& Edge : GraphActor->Edges)
-	{
-		if (!(RenderGroup == EIGVEdgeRenderGroup::Default || Edge.RenderGroup == RenderGroup))
-			continue;
+	// Segments are drawn from the shared template with base vertex offsets instead
+	uint32 const NumSegmentMeshIndices =
+		bLayoutUsesIndexTemplate ? 0 : (NumSegmentSamples - 1) * NumSides * 6;  // Two Triangles
 
+	TArray<TPair<int32, FIGVEdge*>> Splines;
+
+	// A spline of NumSplineSegments, with its control points and segments in the buffers
+	auto const AddSpline = [&](uint32 const NumSplineSegments) {
 		uint32 const BeginControlPointIdx = SplineControlPointData.Num();
-		uint32 const EdgeMeshVertexBufferOffset = NumMeshVertices;
-		uint32 const EdgeMeshIndexBufferOffset = NumMeshIndices;
 		uint32 const SplineIdx = SplineData.Num();
 
-		uint32 const NumSplineControlPoints = Edge.SplineControlPointData.Num();
-		SplineControlPointData.AddUninitialized(NumSplineControlPoints + 4);
+		// Degree 3, so three control points more than segments
+		SplineControlPointData.AddZeroed(NumSplineSegments + 3);
 
-		// NumSplineControlPoints + 3 - 2. Degree - First and Last Control Point
-		uint32 const NumSplineSegments = NumSplineControlPoints + 1;
+		SplineBeginSegmentIdxs.Add(SplineSegmentData.Num());
 
+		// Buffer offsets are assigned with the slots below
 		for (uint32 SegmentIdx = 0; SegmentIdx < NumSplineSegments; SegmentIdx++)
 		{
-			uint32 const SegmentMeshVertexBufferOffset = NumMeshVertices;
-			uint32 const SegmentMeshIndexBufferOffset = NumMeshIndices;
-
 			SplineSegmentData.Emplace(
 				FIGVEdgeSplineSegmentData{SplineIdx,						  //
 										  BeginControlPointIdx + SegmentIdx,  //
 										  NumSegmentSamples,				  //
-										  SegmentMeshVertexBufferOffset,	  //
-										  SegmentMeshIndexBufferOffset});
+										  0,								  //
+										  0});
 
-			uint32 const NumSegmentMeshIndices =
-				(NumSegmentSamples - 1) * NumSides * 6;  // Two Triangles
 			MeshIndices.AddUninitialized(NumSegmentMeshIndices);
 
 			NumMeshVertices += NumSides * NumSegmentSamples;
 			NumMeshIndices += NumSegmentMeshIndices;  // Two Triangles
 		}
 
-		AIGVNodeActor const& SourceNode = *Edge.SourceNode;
-		AIGVNodeActor const& TargetNode = *Edge.TargetNode;
-		SplineData.Emplace(
-			FIGVEdgeSplineData{SourceNode.Pos3D,									 //
-							   TargetNode.Pos3D,									 //
-							   UKWColorSpace::RGBtoHCL(SourceNode.Color),			 //
-							   UKWColorSpace::RGBtoHCL(TargetNode.Color),			 //
-							   Edge.BundlingStrength(),								 //
-							   BeginControlPointIdx,								 //
-							   SplineControlPointData.Num() - BeginControlPointIdx,  //
-							   EdgeMeshVertexBufferOffset});
+		// The remaining fields are written by UpdateSplines
+		FIGVEdgeSplineData& Spline = SplineData[SplineData.AddDefaulted()];
+		Spline.BeginControlPointIdx = BeginControlPointIdx;
+		Spline.NumControlPoints = SplineControlPointData.Num() - BeginControlPointIdx;
 
-		FIGVEdgeMeshData& MeshData = Edge.MeshData;
-		MeshData.VertexBufferOffset[RenderGroup] = EdgeMeshVertexBufferOffset;
-		MeshData.VertexBufferSize[RenderGroup] = NumMeshVertices - EdgeMeshVertexBufferOffset;
-		MeshData.IndexBufferOffset[RenderGroup] = EdgeMeshIndexBufferOffset;
-		MeshData.IndexBufferSize[RenderGroup] = NumMeshIndices - EdgeMeshIndexBufferOffset;
-	}
+		// Free until it is given an edge
+		SplineEdgeSlotIdxs.Add(INDEX_NONE);
+		SplineRenderGroups.Add(EIGVEdgeRenderGroup::NumGroups);
+		return SplineIdx;
+	};
 
-	FGraphEventArray Tasks;
-	uint32 SplineIdx = 0;
 	for (FIGVEdge& Edge : GraphActor->Edges)
 	{
-		if (!(RenderGroup == EIGVEdgeRenderGroup::Default || Edge.RenderGroup == RenderGroup))
-			continue;
+		if (!IsInGroup(Edge)) continue;
 
-		FIGVEdgeSplineData& Spline = SplineData[SplineIdx];
-		SplineIdx++;
+		// Edge.NumControlPoints + 3 - 2. Degree - First and Last Control Point
+		int32 const SplineIdx = AddSpline(Edge.NumControlPoints + 1);
 
-		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&] {
-			auto const& ControlPoints = Edge.SplineControlPointData;
+		SplineRenderGroups[SplineIdx] = Edge.RenderGroup;
+		SetSplineEdgeSlot(SplineIdx, Edge.StoreSlotIdx);
+		Splines.Emplace(SplineIdx, &Edge);
+	}
 
-			uint32 const I = Spline.BeginControlPointIdx;
-			uint32 const J = I + Spline.NumControlPoints - 1;
+	// Spare splines for edited edges, with room for the longest path through the hierarchy (see
+	// FIGVEdgeStore::SetupClusters), so that an edge edit leaves the buffers in place
+	if (RenderGroup == EIGVEdgeRenderGroup::Default && GraphActor->RootCluster != nullptr)
+	{
+		uint32 NumSpareSegments = 2 * GraphActor->RootCluster->Height + 4;
+		for (TPair<int32, FIGVEdge*> const& Spline : Splines)
+		{
+			NumSpareSegments = FMath::Max<uint32>(NumSpareSegments,
+												  Spline.Value->NumControlPoints + 1);
+		}
+
+		int32 const NumSpareSplines = FMath::Max(16, NumEdgeSplines / 32);
+		for (int32 Idx = 0; Idx < NumSpareSplines; Idx++)
+		{
+			int32 const SplineIdx = AddSpline(NumSpareSegments);
+			SplineData[SplineIdx].NumControlPoints = 3;  // No segment in use
+			FreeSplineIdxs.Add(SplineIdx);
+		}
+	}
 
-			SplineControlPointData[I] = SplineControlPointData[I + 1] = ControlPoints[0];
-			FMemory::Memcpy(&SplineControlPointData[I + 2], ControlPoints.GetData(),
-							sizeof(FIGVEdgeSplineControlPointData) * ControlPoints.Num());
-			SplineControlPointData[J - 1] = SplineControlPointData[J] = ControlPoints.Last();
-		}));
+	// Slots in the order of render group, then lowest common ancestor for locality
+	TArray<int32> SplineOrder;
+	SplineOrder.SetNumUninitialized(Splines.Num());
+	for (int32 SplineIdx = 0; SplineIdx < Splines.Num(); SplineIdx++)
+	{
+		SplineOrder[SplineIdx] = SplineIdx;
 	}
 
-	for (FIGVEdgeSplineSegmentData& Segment : SplineSegmentData)
+	auto const GetSortKey = [&](int32 const SplineIdx) {
+		FIGVEdge const& Edge = *Splines[SplineIdx].Value;
+		int32 const LCAIdx = Edge.LowestCommonAncestor ? Edge.LowestCommonAncestor->Idx : -1;
+		return (int64(SplineRenderGroups[SplineIdx]) << 32) | uint32(LCAIdx);
+	};
+	SplineOrder.Sort([&](int32 const A, int32 const B) {
+		int64 const KeyA = GetSortKey(A);
+		int64 const KeyB = GetSortKey(B);
+		return KeyA < KeyB || (KeyA == KeyB && A < B);
+	});
+
+	SegmentSlotIdxs.SetNumUninitialized(SplineSegmentData.Num());
+	SlotSegmentIdxs.SetNumUninitialized(SplineSegmentData.Num());
+	SegmentCurvatures.SetNumZeroed(SplineSegmentData.Num());
+	SegmentSampleLODs.SetNumZeroed(SplineSegmentData.Num());
+	SlotLODs.SetNumZeroed(SplineSegmentData.Num());
+	SlotLODDirtyChunks.Init(false, FMath::DivideAndRoundUp(SlotLODs.Num(), NumChunkSlots));
+	FMemory::Memzero(GroupBeginSlotIdxs);
+
+	int32 SlotIdx = 0;
+	for (int32 const SplineIdx : SplineOrder)
+	{
+		int32 const BeginSegmentIdx = SplineBeginSegmentIdxs[SplineIdx];
+		int32 const EndSegmentIdx = BeginSegmentIdx + SplineData[SplineIdx].NumControlPoints - 3;
+		for (int32 SegmentIdx = BeginSegmentIdx; SegmentIdx < EndSegmentIdx; SegmentIdx++)
+		{
+			SetSegmentSlot(SegmentIdx, SlotIdx++);
+		}
+		GroupBeginSlotIdxs[SplineRenderGroups[SplineIdx] + 1] = SlotIdx;
+	}
+	for (int32 Group = 1; Group <= EIGVEdgeRenderGroup::NumGroups; Group++)
 	{
-		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&] {
-			uint32 const SegmentMeshVertexBufferOffset = Segment.MeshVertexBufferOffset;
-			uint32 const SegmentMeshIndexBufferOffset = Segment.MeshIndexBufferOffset;
+		GroupBeginSlotIdxs[Group] =
+			FMath::Max(GroupBeginSlotIdxs[Group], GroupBeginSlotIdxs[Group - 1]);
+	}
 
-			uint32 Idx = 0;
-			for (uint32 SampleIdx = 0; SampleIdx < Segment.NumSamples - 1; SampleIdx++)
+	// The segments of the spare splines take the free slots
+	for (int32 const SplineIdx : FreeSplineIdxs)
+	{
+		for (int32 SegmentIdx = SplineBeginSegmentIdxs[SplineIdx];
+			 SegmentIdx < GetSplineEndSegmentIdx(SplineIdx); SegmentIdx++)
+		{
+			SetSegmentSlot(SegmentIdx, SlotIdx++);
+		}
+	}
+
+	if (!bLayoutUsesIndexTemplate)
+	{
+		KWParallelFor(SplineSegmentData.Num(), [&](int32 const Begin, int32 const End) {
+			for (int32 SegmentIdx = Begin; SegmentIdx < End; SegmentIdx++)
 			{
-				for (uint32 SideIdx = 0; SideIdx < NumSides; SideIdx++)
-				{
-					uint32 const TopLeft =
-						SegmentMeshVertexBufferOffset + GetVertexIdx(NumSides, SampleIdx, SideIdx);
-					uint32 const BottomLeft = SegmentMeshVertexBufferOffset +
-											  GetVertexIdx(NumSides, SampleIdx, SideIdx + 1);
-					uint32 const TopRight = SegmentMeshVertexBufferOffset +
-											GetVertexIdx(NumSides, SampleIdx + 1, SideIdx);
-					uint32 const BottomRight = SegmentMeshVertexBufferOffset +
-											   GetVertexIdx(NumSides, SampleIdx + 1, SideIdx + 1);
-
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx] = TopLeft;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 1] = BottomLeft;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 2] = TopRight;
-
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 3] = TopRight;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 4] = BottomLeft;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 5] = BottomRight;
-
-					Idx += 6;
-				}
+				FIGVEdgeSplineSegmentData const& Segment = SplineSegmentData[SegmentIdx];
+				WriteSegmentMeshIndices(Segment.MeshVertexBufferOffset, Segment.NumSamples,
+										NumSides, &MeshIndices[Segment.MeshIndexBufferOffset]);
 			}
-		}));
+		});
 	}
-	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+
+	UpdateSplines(Splines);
 
 	check(NumMeshIndices == MeshIndices.Num());
 
-	MarkRenderStateDirty();
+	// Reorders slots within chunks, before the new proxy takes the whole layout
+	TArray<FIGVEdgeMeshRange> AllSplines;
+	if (SplineData.Num() > 0) AllSplines.Add(FIGVEdgeMeshRange{0, SplineData.Num()});
+	NumSampledVertices = SplineSegmentData.Num() * NumSides * NumSegmentSamples;  // Level 0
+	UpdateSampleLODs(AllSplines, true);
+	DirtySplineRanges.Reset();
+	bSlotLODsChanged = false;
+	SlotLODDirtyChunks.Init(false, SlotLODDirtyChunks.Num());
+
+	UpdateDrawSlotRange();
+	bDrawSlotRangeChanged = false;
+
+	UpdateChunkBounds(TArray<FIGVEdgeMeshRange>());  // All chunks, since they were reset
+	bChunkBoundsChanged = false;
+	BoundsDirtyChunks.Init(false, ChunkBounds.Num());
+
+	ChunkLODs.SetNumZeroed(ChunkBounds.Num());  // Full detail until the next UpdateLOD
+
+	// New buffer sizes, so the scene proxy is recreated
+	bRenderStateDirty = true;
 
 	// IGV_LOG(Log, TEXT("UIGVEdgeMeshComponent::Update (%s) NumSplineSegmentData=%d"),
 	// 		*UEnum::GetValueAsString(TEXT("ImsvGraphVis.EIGVEdgeRenderGroup"), RenderGroup),
 	// 		SplineSegmentData.Num());
 }
 
+void UIGVEdgeMeshComponent::UpdateSplines(TArray<TPair<int32, FIGVEdge*>> const& Splines)
+{
+	KWParallelFor(Splines.Num(), [&](int32 const Begin, int32 const End) {
+		for (int32 Idx = Begin; Idx < End; Idx++)
+		{
+			FIGVEdge const& Edge = *Splines[Idx].Value;
+			FIGVEdgeSplineData& Spline = SplineData[Splines[Idx].Key];
+
+			AIGVNodeActor const& SourceNode = *Edge.SourceNode;
+			AIGVNodeActor const& TargetNode = *Edge.TargetNode;
+			Spline.StartPosition = SourceNode.Pos3D;
+			Spline.EndPosition = TargetNode.Pos3D;
+			Spline.StartColor_HCL = UKWColorSpace::RGBtoHCL(SourceNode.Color);
+			Spline.EndColor_HCL = UKWColorSpace::RGBtoHCL(TargetNode.Color);
+			Spline.BundlingStrength = GraphActor->Edges.BundlingStrength(Edge);
+
+			uint32 const I = Spline.BeginControlPointIdx;
+			uint32 const J = I + Spline.NumControlPoints - 1;
+
+			GraphActor->Edges.ResolveSplineControlPoints(
+				Edge, RenderGroup == EIGVEdgeRenderGroup::Default, &SplineControlPointData[I + 2]);
+
+			// Repeat the end points to clamp the spline
+			SplineControlPointData[I] = SplineControlPointData[I + 1] =
+				SplineControlPointData[I + 2];
+			SplineControlPointData[J - 1] = SplineControlPointData[J] =
+				SplineControlPointData[J - 2];
+		}
+	});
+}
+
+void UIGVEdgeMeshComponent::SetSegmentSlot(int32 const SegmentIdx, int32 const SlotIdx)
+{
+	int32 const ChunkIdx = SlotIdx / NumChunkSlots;
+	int32 const ChunkLOD = ChunkLODs.IsValidIndex(ChunkIdx) ? ChunkLODs[ChunkIdx] : 0;
+	uint8 const LOD = FMath::Min(SegmentSampleLODs[SegmentIdx] + ChunkLOD, NumLODs - 1);
+
+	if (SlotLODs[SlotIdx] != LOD)
+	{
+		SlotLODs[SlotIdx] = LOD;
+		bSlotLODsChanged = true;
+		SlotLODDirtyChunks[ChunkIdx] = true;
+	}
+
+	FIGVEdgeSplineSegmentData& Segment = SplineSegmentData[SegmentIdx];
+	Segment.NumSamples = GetEdgeLODNumSamples(LayoutNumSegmentSamples, LOD);
+	Segment.MeshVertexBufferOffset = SlotIdx * LayoutNumSides * LayoutNumSegmentSamples;
+	Segment.MeshIndexBufferOffset =
+		bLayoutUsesIndexTemplate ? 0 : SlotIdx * (LayoutNumSegmentSamples - 1) * LayoutNumSides * 6;
+
+	if (SplineBeginSegmentIdxs[Segment.SplineIdx] == SegmentIdx)
+	{
+		SplineData[Segment.SplineIdx].MeshVertexBufferOffset = Segment.MeshVertexBufferOffset;
+	}
+
+	SegmentSlotIdxs[SegmentIdx] = SlotIdx;
+	SlotSegmentIdxs[SlotIdx] = SegmentIdx;
+}
+
+void UIGVEdgeMeshComponent::SwapSlots(int32 const SlotIdxA, int32 const SlotIdxB,
+									  TBitArray<>& DirtySplines)
+{
+	if (SlotIdxA == SlotIdxB) return;
+
+	int32 const SegmentIdxA = SlotSegmentIdxs[SlotIdxA];
+	int32 const SegmentIdxB = SlotSegmentIdxs[SlotIdxB];
+	SetSegmentSlot(SegmentIdxA, SlotIdxB);
+	SetSegmentSlot(SegmentIdxB, SlotIdxA);
+
+	DirtySplines[SplineSegmentData[SegmentIdxA].SplineIdx] = true;
+	DirtySplines[SplineSegmentData[SegmentIdxB].SplineIdx] = true;
+}
+
+void UIGVEdgeMeshComponent::MoveSegment(int32 const SegmentIdx, int32 const OldGroup,
+										int32 const NewGroup, TBitArray<>& DirtySplines)
+{
+	// The segment walks across the group boundaries in between, one swap per boundary. The free
+	// slots follow the last group, as group NumGroups.
+	for (int32 Group = OldGroup; Group < NewGroup; Group++)
+	{
+		int32 const LastSlotIdx = --GroupBeginSlotIdxs[Group + 1];
+		SwapSlots(SegmentSlotIdxs[SegmentIdx], LastSlotIdx, DirtySplines);
+	}
+	for (int32 Group = OldGroup; Group > NewGroup; Group--)
+	{
+		int32 const FirstSlotIdx = GroupBeginSlotIdxs[Group]++;
+		SwapSlots(SegmentSlotIdxs[SegmentIdx], FirstSlotIdx, DirtySplines);
+	}
+	DirtySplines[SplineSegmentData[SegmentIdx].SplineIdx] = true;
+}
+
+void UIGVEdgeMeshComponent::MoveSpline(int32 const SplineIdx,
+									   EIGVEdgeRenderGroup::Type const NewRenderGroup,
+									   TBitArray<>& DirtySplines)
+{
+	int32 const BeginSegmentIdx = SplineBeginSegmentIdxs[SplineIdx];
+	int32 const EndSegmentIdx = BeginSegmentIdx + SplineData[SplineIdx].NumControlPoints - 3;
+	for (int32 SegmentIdx = BeginSegmentIdx; SegmentIdx < EndSegmentIdx; SegmentIdx++)
+	{
+		MoveSegment(SegmentIdx, SplineRenderGroups[SplineIdx], NewRenderGroup, DirtySplines);
+	}
+
+	SplineRenderGroups[SplineIdx] = NewRenderGroup;
+}
+
+void UIGVEdgeMeshComponent::ResizeSpline(int32 const SplineIdx, int32 const NumSegments,
+										 TBitArray<>& DirtySplines)
+{
+	check(NumSegments <= GetSplineEndSegmentIdx(SplineIdx) - SplineBeginSegmentIdxs[SplineIdx]);
+
+	// Segments past NumSegments stay with the spline, in the free slots
+	int32 const Group = SplineRenderGroups[SplineIdx];
+	int32 const BeginSegmentIdx = SplineBeginSegmentIdxs[SplineIdx];
+	int32 const OldNumSegments = SplineData[SplineIdx].NumControlPoints - 3;
+	for (int32 Idx = OldNumSegments; Idx < NumSegments; Idx++)
+	{
+		MoveSegment(BeginSegmentIdx + Idx, EIGVEdgeRenderGroup::NumGroups, Group, DirtySplines);
+	}
+	for (int32 Idx = NumSegments; Idx < OldNumSegments; Idx++)
+	{
+		MoveSegment(BeginSegmentIdx + Idx, Group, EIGVEdgeRenderGroup::NumGroups, DirtySplines);
+	}
+
+	SplineData[SplineIdx].NumControlPoints = NumSegments + 3;
+	DirtySplines[SplineIdx] = true;
+}
+
+void UIGVEdgeMeshComponent::SetSplineEdgeSlot(int32 const SplineIdx, int32 const EdgeSlotIdx)
+{
+	if (EdgeSlotSplineIdxs.Num() <= EdgeSlotIdx)
+	{
+		int32 const NumEdgeSlots = EdgeSlotSplineIdxs.Num();
+		EdgeSlotSplineIdxs.SetNumUninitialized(EdgeSlotIdx + 1);
+		for (int32 Idx = NumEdgeSlots; Idx < EdgeSlotSplineIdxs.Num(); Idx++)
+		{
+			EdgeSlotSplineIdxs[Idx] = INDEX_NONE;
+		}
+	}
+	EdgeSlotSplineIdxs[EdgeSlotIdx] = SplineIdx;
+	SplineEdgeSlotIdxs[SplineIdx] = EdgeSlotIdx;
+	NumEdgeSplines++;
+}
+
+void UIGVEdgeMeshComponent::FreeSpline(int32 const SplineIdx, TBitArray<>& DirtySplines)
+{
+	ResizeSpline(SplineIdx, 0, DirtySplines);
+	SplineRenderGroups[SplineIdx] = EIGVEdgeRenderGroup::NumGroups;
+
+	EdgeSlotSplineIdxs[SplineEdgeSlotIdxs[SplineIdx]] = INDEX_NONE;
+	SplineEdgeSlotIdxs[SplineIdx] = INDEX_NONE;
+	NumEdgeSplines--;
+
+	FreeSplineIdxs.Add(SplineIdx);
+}
+
+bool UIGVEdgeMeshComponent::AddDirtySplines(TBitArray<> const& DirtySplines)
+{
+	return AddSetBitRanges(DirtySplines, DirtySplineRanges);
+}
+
+void UIGVEdgeMeshComponent::UpdateDrawSlotRange()
+{
+	FIGVEdgeMeshRange const NewDrawSlotRange{GroupBeginSlotIdxs[RenderGroup],
+											 GroupBeginSlotIdxs[RenderGroup + 1]};
+	if (!(NewDrawSlotRange == DrawSlotRange))
+	{
+		DrawSlotRange = NewDrawSlotRange;
+		bDrawSlotRangeChanged = true;
+	}
+}
+
+void UIGVEdgeMeshComponent::UpdateSampleLODs(TArray<FIGVEdgeMeshRange> const& SplineRanges,
+											 bool const bFitTolerance)
+{
+	// A full index buffer has one fixed tessellation per slot
+	if (!bLayoutUsesIndexTemplate)
+	{
+		NumSampledVertices = SplineSegmentData.Num() * LayoutNumSides * LayoutNumSegmentSamples;
+		return;
+	}
+
+	FIGVEdgeMeshTessellator const Tessellator(SplineControlPointData, SplineData,
+											  GetSplineParameters());
+
+	// SplineRanges may be DirtySplineRanges, so they are only read before AddDirtySplines. The
+	// segments of all ranges are numbered consecutively, so that small ranges share chunks.
+	TArray<FIGVEdgeMeshRange> SegmentRanges;
+	for (FIGVEdgeMeshRange const& Range : SplineRanges)
+	{
+		int32 const EndSegmentIdx = Range.End < SplineBeginSegmentIdxs.Num()
+										? SplineBeginSegmentIdxs[Range.End]
+										: SplineSegmentData.Num();
+		SegmentRanges.Add(FIGVEdgeMeshRange{SplineBeginSegmentIdxs[Range.Begin], EndSegmentIdx});
+	}
+
+	TArray<int32> RangeOffsets;
+	RangeOffsets.SetNumUninitialized(SegmentRanges.Num());
+	int32 const NumRangeSegments = KWParallelPrefixSum<int32>(
+		SegmentRanges.Num(),
+		[&](int32 const RangeIdx) {
+			return SegmentRanges[RangeIdx].End - SegmentRanges[RangeIdx].Begin;
+		},
+		[&](int32 const RangeIdx, int32 const Offset) { RangeOffsets[RangeIdx] = Offset; });
+
+	int32 const FreeBeginSlotIdx = GroupBeginSlotIdxs[EIGVEdgeRenderGroup::NumGroups];
+	KWParallelFor(NumRangeSegments, [&](int32 const Begin, int32 const End) {
+		// The last range starting at or before Begin; empty ranges share their offset
+		int32 RangeIdx = Algo::UpperBound(RangeOffsets, Begin) - 1;
+		for (int32 Idx = Begin; Idx < End; Idx++)
+		{
+			while (RangeIdx + 1 < RangeOffsets.Num() && RangeOffsets[RangeIdx + 1] <= Idx)
+			{
+				RangeIdx++;
+			}
+			int32 const SegmentIdx = SegmentRanges[RangeIdx].Begin + Idx - RangeOffsets[RangeIdx];
+			SegmentCurvatures[SegmentIdx] =
+				SegmentSlotIdxs[SegmentIdx] < FreeBeginSlotIdx
+					? Tessellator.CalcSegmentCurvature(SplineSegmentData[SegmentIdx])
+					: 0.f;  // Unused, at the coarsest level
+		}
+	}, 256);
+
+	TBitArray<> DirtySplines(false, SplineData.Num());
+	if (bFitTolerance)
+	{
+		// The tolerance is global, so any segment may change its level
+		SampleTolerance = FitSampleTolerance();
+		for (int32 SegmentIdx = 0; SegmentIdx < SplineSegmentData.Num(); SegmentIdx++)
+		{
+			UpdateSampleLOD(SegmentIdx, DirtySplines);
+		}
+	}
+	else
+	{
+		for (FIGVEdgeMeshRange const& Range : SegmentRanges)
+		{
+			for (int32 SegmentIdx = Range.Begin; SegmentIdx < Range.End; SegmentIdx++)
+			{
+				UpdateSampleLOD(SegmentIdx, DirtySplines);
+			}
+		}
+	}
+
+	// Sorting the chunks also assigns the new sample counts
+	SortChunks(DirtySplines);
+	AddDirtySplines(DirtySplines);
+}
+
+float UIGVEdgeMeshComponent::FitSampleTolerance() const
+{
+	if (!GraphActor->bAdaptiveEdgeSampling) return 0.f;
+
+	FIGVFrameGovernor const& FrameGovernor = GraphActor->FrameGovernor;
+	float const Tolerance = GraphActor->EdgeSampleTolerance * GraphActor->EdgeWidth *
+							FrameGovernor.GetSampleToleranceScale();
+	int64 const VertexBudget =
+		int64(GraphActor->EdgeVertexBudget * FrameGovernor.GetVertexBudgetScale());
+
+	auto const CountVertices = [this](float const InTolerance) {
+		int64 NumSamples = 0;
+		for (float const Curvature : SegmentCurvatures)
+		{
+			NumSamples += GetEdgeLODNumSamples(LayoutNumSegmentSamples,
+											   CalcSampleLOD(Curvature, InTolerance));
+		}
+		return NumSamples * LayoutNumSides;
+	};
+
+	if (VertexBudget <= 0 || CountVertices(Tolerance) <= VertexBudget) return Tolerance;
+
+	// Bisect between the requested tolerance and the one at which every segment is at the
+	// coarsest level; if even that exceeds the budget, the coarsest level is used
+	float MaxCurvature = 0.f;
+	for (float const Curvature : SegmentCurvatures)
+	{
+		MaxCurvature = FMath::Max(MaxCurvature, Curvature);
+	}
+	float const NumCoarsestIntervals =
+		GetEdgeLODNumSamples(LayoutNumSegmentSamples, NumLODs - 1) - 1;
+
+	float Low = Tolerance;
+	float High = MaxCurvature / (8 * NumCoarsestIntervals * NumCoarsestIntervals);
+	if (High <= Low) return Tolerance;
+
+	for (int32 Iteration = 0; Iteration < 16; Iteration++)
+	{
+		float const Mid = 0.5f * (Low + High);
+		if (CountVertices(Mid) <= VertexBudget)
+		{
+			High = Mid;
+		}
+		else
+		{
+			Low = Mid;
+		}
+	}
+	return High;
+}
+
+uint8 UIGVEdgeMeshComponent::CalcSampleLOD(float const Curvature, float const Tolerance) const
+{
+	if (Tolerance <= 0.f) return 0;
+
+	// Coarsest level that stays within the tolerance
+	for (int32 LOD = NumLODs - 1; LOD > 0; LOD--)
+	{
+		float const NumIntervals = GetEdgeLODNumSamples(LayoutNumSegmentSamples, LOD) - 1;
+		if (Curvature <= 8 * NumIntervals * NumIntervals * Tolerance) return LOD;
+	}
+	return 0;
+}
+
+void UIGVEdgeMeshComponent::UpdateSampleLOD(int32 const SegmentIdx, TBitArray<>& DirtySplines)
+{
+	uint8 const OldLOD = SegmentSampleLODs[SegmentIdx];
+	uint8 const LOD = CalcSampleLOD(SegmentCurvatures[SegmentIdx], SampleTolerance);
+	if (LOD == OldLOD) return;
+
+	NumSampledVertices += (int32(GetEdgeLODNumSamples(LayoutNumSegmentSamples, LOD)) -
+						   int32(GetEdgeLODNumSamples(LayoutNumSegmentSamples, OldLOD))) *
+						  LayoutNumSides;
+	SegmentSampleLODs[SegmentIdx] = LOD;
+	DirtySplines[SplineSegmentData[SegmentIdx].SplineIdx] = true;
+}
+
+void UIGVEdgeMeshComponent::SortChunks(TBitArray<>& DirtySplines)
+{
+	if (!bLayoutUsesIndexTemplate) return;
+
+	int32 const NumChunks = FMath::DivideAndRoundUp(SlotSegmentIdxs.Num(), NumChunkSlots);
+	TBitArray<> DirtyChunks(false, NumChunks);
+	for (TConstSetBitIterator<> It(DirtySplines); It; ++It)
+	{
+		int32 const SplineIdx = It.GetIndex();
+		int32 const BeginSegmentIdx = SplineBeginSegmentIdxs[SplineIdx];
+		int32 const EndSegmentIdx = BeginSegmentIdx + SplineData[SplineIdx].NumControlPoints - 3;
+		for (int32 SegmentIdx = BeginSegmentIdx; SegmentIdx < EndSegmentIdx; SegmentIdx++)
+		{
+			DirtyChunks[SegmentSlotIdxs[SegmentIdx] / NumChunkSlots] = true;
+		}
+	}
+
+	// Segments only move within their chunk, so no further chunks become dirty
+	for (TConstSetBitIterator<> It(DirtyChunks); It; ++It)
+	{
+		int32 const BeginSlotIdx = It.GetIndex() * NumChunkSlots;
+		int32 const EndSlotIdx = FMath::Min(BeginSlotIdx + NumChunkSlots, SlotSegmentIdxs.Num());
+		for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+		{
+			FIGVEdgeMeshRange const SlotRange{
+				FMath::Max(BeginSlotIdx, GroupBeginSlotIdxs[Group]),
+				FMath::Min(EndSlotIdx, GroupBeginSlotIdxs[Group + 1])};
+			if (SlotRange.Begin < SlotRange.End) SortSlots(SlotRange, DirtySplines);
+		}
+	}
+}
+
+void UIGVEdgeMeshComponent::SortSlots(FIGVEdgeMeshRange const& SlotRange,
+									  TBitArray<>& DirtySplines)
+{
+	TArray<int32, TInlineAllocator<NumChunkSlots>> Segments;
+	Segments.Append(&SlotSegmentIdxs[SlotRange.Begin], SlotRange.End - SlotRange.Begin);
+	Segments.StableSort([this](int32 const A, int32 const B) {
+		return SegmentSampleLODs[A] < SegmentSampleLODs[B];
+	});
+
+	for (int32 Idx = 0; Idx < Segments.Num(); Idx++)
+	{
+		int32 const SegmentIdx = Segments[Idx];
+		int32 const SlotIdx = SlotRange.Begin + Idx;
+		FIGVEdgeSplineSegmentData const& Segment = SplineSegmentData[SegmentIdx];
+
+		bool const bMoved = SegmentSlotIdxs[SegmentIdx] != SlotIdx;
+		uint32 const NumSamples = Segment.NumSamples;
+		SetSegmentSlot(SegmentIdx, SlotIdx);
+
+		if (bMoved || Segment.NumSamples != NumSamples)
+		{
+			DirtySplines[Segment.SplineIdx] = true;
+		}
+	}
+}
+
+FSplineComputeShaderUniformParameters UIGVEdgeMeshComponent::GetSplineParameters() const
+{
+	FSplineComputeShaderUniformParameters Parameters;
+	Parameters.WorldSize = GraphActor->GetSphereRadius();
+	Parameters.Width = GraphActor->EdgeWidth * 0.5;
+	Parameters.NumSides = LayoutNumSides;
+	return Parameters;
+}
+
+void UIGVEdgeMeshComponent::UpdateChunkBounds(TArray<FIGVEdgeMeshRange> const& SplineRanges)
+{
+	int32 const NumChunks = FMath::DivideAndRoundUp(SlotSegmentIdxs.Num(), NumChunkSlots);
+	bool const bAllChunks = ChunkBounds.Num() != NumChunks;
+	ChunkBounds.SetNumZeroed(NumChunks);
+
+	TBitArray<> DirtyChunks(bAllChunks, NumChunks);
+	if (BoundsDirtyChunks.Num() != NumChunks) BoundsDirtyChunks.Init(false, NumChunks);
+	if (!bAllChunks)
+	{
+		for (FIGVEdgeMeshRange const& Range : SplineRanges)
+		{
+			int32 const EndSegmentIdx = Range.End < SplineBeginSegmentIdxs.Num()
+											? SplineBeginSegmentIdxs[Range.End]
+											: SplineSegmentData.Num();
+			for (int32 SegmentIdx = SplineBeginSegmentIdxs[Range.Begin];
+				 SegmentIdx < EndSegmentIdx; SegmentIdx++)
+			{
+				DirtyChunks[SegmentSlotIdxs[SegmentIdx] / NumChunkSlots] = true;
+			}
+		}
+	}
+
+	FIGVEdgeMeshTessellator const Tessellator(SplineControlPointData, SplineData,
+											  GetSplineParameters());
+
+	TArray<int32> DirtyChunkIdxs;
+	for (TConstSetBitIterator<> It(DirtyChunks); It; ++It)
+	{
+		DirtyChunkIdxs.Add(It.GetIndex());
+	}
+	if (DirtyChunkIdxs.Num() == 0) return;
+
+	float const RelativeMargin = GraphActor->EdgeChunkBoundsMargin;
+	int32 const FreeBeginSlotIdx = GroupBeginSlotIdxs[EIGVEdgeRenderGroup::NumGroups];
+	KWParallelFor(DirtyChunkIdxs.Num(), [&](int32 const Begin, int32 const End) {
+		for (int32 Idx = Begin; Idx < End; Idx++)
+		{
+			int32 const ChunkIdx = DirtyChunkIdxs[Idx];
+			int32 const BeginSlotIdx = ChunkIdx * NumChunkSlots;
+			int32 const EndSlotIdx = FMath::Min(BeginSlotIdx + NumChunkSlots, FreeBeginSlotIdx);
+
+			FBox Bounds(ForceInit);
+			for (int32 SlotIdx = BeginSlotIdx; SlotIdx < EndSlotIdx; SlotIdx++)
+			{
+				int32 const SegmentIdx = SlotSegmentIdxs[SlotIdx];
+				Bounds += Tessellator.CalcSegmentBounds(SplineSegmentData[SegmentIdx],
+														RelativeMargin);
+			}
+			ChunkBounds[ChunkIdx] = Bounds;
+		}
+	});
+	for (int32 const ChunkIdx : DirtyChunkIdxs)
+	{
+		BoundsDirtyChunks[ChunkIdx] = true;
+	}
+	bChunkBoundsChanged = true;
+
+	FBox const NewLocalBounds = KWParallelReduce(
+		ChunkBounds.Num(), FBox(ForceInit),
+		[this](int32 const Begin, int32 const End) {
+			FBox Bounds(ForceInit);
+			for (int32 ChunkIdx = Begin; ChunkIdx < End; ChunkIdx++)
+			{
+				Bounds += ChunkBounds[ChunkIdx];
+			}
+			return Bounds;
+		},
+		[](FBox const& A, FBox const& B) { return A + B; }, 1024);
+
+	if (!NewLocalBounds.Equals(LocalBounds))
+	{
+		LocalBounds = NewLocalBounds;
+		bBoundsDirty = true;
+	}
+}
+
 FIGVEdgeMeshSceneProxy* UIGVEdgeMeshComponent::GetSceneProxy() const
 {
 	return (FIGVEdgeMeshSceneProxy*)SceneProxy;
 }
 
-void UIGVEdgeMeshComponent::SendRenderDynamicData_Concurrent()
+void UIGVEdgeMeshComponent::FlushRenderUpdates()
 {
-	if (SceneProxy)
+	check(IsInGameThread());
+
+	if (bBoundsDirty)
+	{
+		FlushedLocalBounds = LocalBounds;
+		UpdateBounds();
+		MarkRenderTransformDirty();
+		bBoundsDirty = false;
+	}
+
+	// Sent right away rather than at the end of the frame, when the next update may be running
+	if (bRenderStateDirty)
+	{
+		// The new proxy takes the whole layout
+		if (IsRenderStateCreated()) RecreateRenderState_Concurrent();
+	}
+	else if (bRenderDynamicDataDirty && SceneProxy)
 	{
 		GetSceneProxy()->SendRenderDynamicData();
 	}
+
+	// Consumed by the scene proxy
+	bRenderStateDirty = false;
+	bRenderDynamicDataDirty = false;
+	DirtySplineRanges.Reset();
+	bDrawSlotRangeChanged = false;
+	if (bChunkBoundsChanged) BoundsDirtyChunks.Init(false, BoundsDirtyChunks.Num());
+	if (bSlotLODsChanged) SlotLODDirtyChunks.Init(false, SlotLODDirtyChunks.Num());
+	bChunkBoundsChanged = false;
+	bSlotLODsChanged = false;
 }
 
 FBoxSphereBounds UIGVEdgeMeshComponent::CalcBounds(const FTransform& LocalToWorld) const
 {
-	FBoxSphereBounds NewBounds;
-	NewBounds.Origin = FVector::ZeroVector;
-	NewBounds.BoxExtent = FVector(HALF_WORLD_MAX, HALF_WORLD_MAX, HALF_WORLD_MAX);
-	NewBounds.SphereRadius = FMath::Sqrt(3.0f * FMath::Square(HALF_WORLD_MAX));
-	return NewBounds;
+	if (!FlushedLocalBounds.IsValid)
+	{
+		return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0);
+	}
+	return FBoxSphereBounds(FlushedLocalBounds.TransformBy(LocalToWorld));
 }
 
 FPrimitiveSceneProxy* UIGVEdgeMeshComponent::CreateSceneProxy()
 {
+	// The engine may recreate the proxy on its own, which reads the arrays an update writes
+	if (GraphActor) GraphActor->WaitForEdgeMeshUpdateTask();
+
 	return SplineControlPointData.Num() > 0 ? new FIGVEdgeMeshSceneProxy(this) : nullptr;
 }
 
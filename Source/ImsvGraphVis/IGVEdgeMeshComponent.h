@@ -12,6 +12,49 @@
 
 #include "IGVEdgeMeshComponent.generated.h"
 
+FORCEINLINE uint32 GetVertexIdx(uint32 const NumSides, uint32 const AlongIdx,
+								uint32 const AroundIdx)
+{
+	return (AlongIdx * NumSides) + (AroundIdx % NumSides);
+}
+
+// Samples per segment at the given level of detail; every level halves them
+FORCEINLINE uint32 GetEdgeLODNumSamples(uint32 const NumSamples, int32 const LOD)
+{
+	return FMath::Max<uint32>(NumSamples >> LOD, 2);
+}
+
+// Two triangles for every quad of a segment's tube: (NumSamples - 1) * NumSides * 6 indices
+template <typename IndexType>
+void WriteSegmentMeshIndices(uint32 const BaseVertexIdx, uint32 const NumSamples,
+							 uint32 const NumSides, IndexType* const Out)
+{
+	uint32 Idx = 0;
+	for (uint32 SampleIdx = 0; SampleIdx < NumSamples - 1; SampleIdx++)
+	{
+		for (uint32 SideIdx = 0; SideIdx < NumSides; SideIdx++)
+		{
+			IndexType const TopLeft = BaseVertexIdx + GetVertexIdx(NumSides, SampleIdx, SideIdx);
+			IndexType const BottomLeft =
+				BaseVertexIdx + GetVertexIdx(NumSides, SampleIdx, SideIdx + 1);
+			IndexType const TopRight =
+				BaseVertexIdx + GetVertexIdx(NumSides, SampleIdx + 1, SideIdx);
+			IndexType const BottomRight =
+				BaseVertexIdx + GetVertexIdx(NumSides, SampleIdx + 1, SideIdx + 1);
+
+			Out[Idx] = TopLeft;
+			Out[Idx + 1] = BottomLeft;
+			Out[Idx + 2] = TopRight;
+
+			Out[Idx + 3] = TopRight;
+			Out[Idx + 4] = BottomLeft;
+			Out[Idx + 5] = BottomRight;
+
+			Idx += 6;
+		}
+	}
+}
+
 UCLASS()
 class IMSVGRAPHVIS_API UIGVEdgeMeshComponent : public UMeshComponent
 {
@@ -32,6 +75,66 @@ public:
 
 	FMeshIndexArray MeshIndices;
 
+	// Buffer layout: the edge slot and first segment of every spline, and the tessellation it was
+	// built with. While it still matches the edges, updates only rewrite the dirty splines.
+	TArray<int32> SplineEdgeSlotIdxs;  // INDEX_NONE for free splines
+	TArray<int32> EdgeSlotSplineIdxs;  // By FIGVEdge::StoreSlotIdx, INDEX_NONE if none
+	TArray<int32> SplineBeginSegmentIdxs;
+	int32 NumEdgeSplines;
+	uint32 LayoutNumSides;
+	uint32 LayoutNumSegmentSamples;
+	bool bLayoutUsesIndexTemplate;  // MeshIndices is left empty
+
+	// Splines rewritten by the last update, for the scene proxy
+	TArray<FIGVEdgeMeshRange> DirtySplineRanges;
+
+	// Every segment takes the same number of vertices and indices, so segments are placed in
+	// fixed-size slots of the buffers. Slots are ordered by render group, then by the lowest common
+	// ancestor of the edge, so each group is one slot range. The Default component holds every
+	// edge but draws only the slots of the Default group; a group change of an edge swaps its
+	// segments with those at the group boundaries.
+	// The free slots after the last group are never drawn. They hold the segments a spline has no
+	// use for, and those of free splines. The Default component keeps spare splines, which edited
+	// edges take until they run out; see UpdateChangedEdges.
+	TArray<int32> FreeSplineIdxs;
+	TArray<int32> SegmentSlotIdxs;
+	TArray<int32> SlotSegmentIdxs;
+	TArray<TEnumAsByte<EIGVEdgeRenderGroup::Type>> SplineRenderGroups;
+	int32 GroupBeginSlotIdxs[EIGVEdgeRenderGroup::NumGroups + 1];
+
+	FIGVEdgeMeshRange DrawSlotRange;
+	bool bDrawSlotRangeChanged;
+
+	// Local bounds of every NumChunkSlots consecutive slots, for culling in the scene proxy. Only
+	// chunks holding segments of dirty splines are recomputed.
+	static int32 const NumChunkSlots = 64;
+	TArray<FBox> ChunkBounds;
+	FBox LocalBounds;
+	bool bChunkBoundsChanged;
+	TBitArray<> BoundsDirtyChunks;  // Since the last flush, so only these are sent to the proxy
+
+	// Levels of detail, each with half the samples of the previous one. A segment's level is its
+	// sampling level, from the curvature of the segment, plus the view level of its chunk. Slots
+	// keep room for full detail, and within a chunk and render group they are ordered by level, so
+	// that a chunk is drawn with few runs of index templates.
+	static int32 const NumLODs = 4;
+	TArray<float> SegmentCurvatures;  // See FIGVEdgeMeshTessellator::CalcSegmentCurvature
+	TArray<uint8> SegmentSampleLODs;
+	TArray<uint8> ChunkLODs;
+	TArray<uint8> SlotLODs;
+	bool bSlotLODsChanged;
+	TBitArray<> SlotLODDirtyChunks;  // Chunks holding slots of changed levels since the last flush
+	float SampleTolerance;  // Fitted to AIGVGraphActor::EdgeVertexBudget
+	int32 NumSampledVertices;  // Kept up to date as segments change their sampling level
+
+	// Updates may run on a task of AIGVGraphActor, so the engine is only notified of them by
+	// FlushRenderUpdates on the game thread. The bounds of the primitive are those of the last
+	// flush, while LocalBounds may be rewritten.
+	bool bRenderStateDirty;
+	bool bRenderDynamicDataDirty;
+	bool bBoundsDirty;
+	FBox FlushedLocalBounds;
+
 	UPROPERTY()
 	class UMaterialInstanceDynamic* MaterialInstance;
 
@@ -42,12 +145,19 @@ public:
 			  EIGVEdgeRenderGroup::Type const InRenderGroup);
 
 	void Setup();
-	void Update();
+	void Update();			  // All edges of the group
+	void UpdateDirtyEdges();  // Edges with bUpdateMeshRequired
+	void UpdateDrawRanges();  // After the render groups of the edges changed
+	// After edges were added or removed; ChangedEdges holds the added edges and those whose path
+	// in the hierarchy or whose end points moved
+	void UpdateChangedEdges(TArray<struct FIGVEdge*> const& ChangedEdges);
+	void UpdateLOD(FVector const& ViewLocation, FVector const& ViewDirection);
+	void UpdateSampling();  // After the sampling tolerance or vertex budget changed
+	void FlushRenderUpdates();  // Game thread only
 
 	class FIGVEdgeMeshSceneProxy* GetSceneProxy() const;
 
 	// Begin USceneComponent interface.
-	virtual void SendRenderDynamicData_Concurrent() override;
 	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
 	// Begin USceneComponent interface.
 
@@ -63,4 +173,45 @@ public:
 	// End UMeshComponent interface.
 
 	void SetHalo(bool const bValue);
+
+protected:
+	bool IsInGroup(struct FIGVEdge const& Edge) const;
+	bool UsesIndexTemplate() const;
+	bool IsTessellationUpToDate() const;
+	bool IsLayoutUpToDate() const;
+	int32 FindSpline(struct FIGVEdge const& Edge) const;
+	int32 GetSplineEndSegmentIdx(int32 const SplineIdx) const;  // Including the unused segments
+
+	void UpdateImpl(bool const bOnlyDirtyEdges);
+	void Rebuild();
+
+	void SetSegmentSlot(int32 const SegmentIdx, int32 const SlotIdx);
+	void SwapSlots(int32 const SlotIdxA, int32 const SlotIdxB, TBitArray<>& DirtySplines);
+	void MoveSegment(int32 const SegmentIdx, int32 const OldGroup, int32 const NewGroup,
+					 TBitArray<>& DirtySplines);
+	void MoveSpline(int32 const SplineIdx, EIGVEdgeRenderGroup::Type const NewRenderGroup,
+					TBitArray<>& DirtySplines);
+	void ResizeSpline(int32 const SplineIdx, int32 const NumSegments, TBitArray<>& DirtySplines);
+	void SetSplineEdgeSlot(int32 const SplineIdx, int32 const EdgeSlotIdx);  // Of a free spline
+	void FreeSpline(int32 const SplineIdx, TBitArray<>& DirtySplines);
+	bool AllocateSplines(TArray<struct FIGVEdge*> const& ChangedEdges, TBitArray<>& DirtySplines,
+						 TArray<TPair<int32, struct FIGVEdge*>>& OutSplines);
+	void UpdateDrawSlotRange();
+	bool AddDirtySplines(TBitArray<> const& DirtySplines);
+	uint8 CalcChunkLOD(int32 const ChunkIdx, FVector const& ViewLocation,
+					   FVector const& ViewDirection) const;
+
+	// Curvature of the segments of the splines, then their sampling levels at SampleTolerance.
+	// Fitting the tolerance again takes several passes over every segment and may change the level
+	// of any of them, so it is left to Rebuild and UpdateSampling.
+	void UpdateSampleLODs(TArray<FIGVEdgeMeshRange> const& SplineRanges, bool const bFitTolerance);
+	float FitSampleTolerance() const;
+	uint8 CalcSampleLOD(float const Curvature, float const Tolerance) const;
+	void UpdateSampleLOD(int32 const SegmentIdx, TBitArray<>& DirtySplines);
+	void SortChunks(TBitArray<>& DirtySplines);  // Chunks holding segments of the dirty splines
+	void SortSlots(FIGVEdgeMeshRange const& SlotRange, TBitArray<>& DirtySplines);
+
+	FSplineComputeShaderUniformParameters GetSplineParameters() const;
+	void UpdateChunkBounds(TArray<FIGVEdgeMeshRange> const& SplineRanges);
+	void UpdateSplines(TArray<TPair<int32, struct FIGVEdge*>> const& Splines);
 };
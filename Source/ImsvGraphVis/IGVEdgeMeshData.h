@@ -27,3 +27,15 @@ struct IMSVGRAPHVIS_API FIGVEdgeMeshData
 
 	FIGVEdgeMeshData();
 };
+
+// Half-open range of splines of an edge mesh component
+struct IMSVGRAPHVIS_API FIGVEdgeMeshRange
+{
+	int32 Begin;
+	int32 End;
+
+	FORCEINLINE bool operator==(FIGVEdgeMeshRange const& Other) const
+	{
+		return Begin == Other.Begin && End == Other.End;
+	}
+};
@@ -4,11 +4,13 @@
 
 #include "IGVEdge.h"
 #include "IGVEdgeMeshComponent.h"
+#include "IGVEdgeMeshTessellator.h"
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
 
-FIGVEdgeMeshVertexBuffer::FIGVEdgeMeshVertexBuffer(int32 const InNumElements)
-	: NumElements(InNumElements)
+FIGVEdgeMeshVertexBuffer::FIGVEdgeMeshVertexBuffer(int32 const InNumElements,
+												   bool const bInUnorderedAccess)
+	: NumElements(InNumElements), bUnorderedAccess(bInUnorderedAccess)
 {
 }
 
@@ -16,9 +18,70 @@ void FIGVEdgeMeshVertexBuffer::InitRHI()
 {
 	checkSlow(NumElements > 0);
 	FRHIResourceCreateInfo CreateInfo;
-	VertexBufferRHI =
-		RHICreateVertexBuffer(NumElements * sizeof(FDynamicMeshVertex),
-							  BUF_UnorderedAccess | BUF_ByteAddressBuffer, CreateInfo);
+	VertexBufferRHI = RHICreateVertexBuffer(
+		NumElements * sizeof(FDynamicMeshVertex),
+		bUnorderedAccess ? (BUF_UnorderedAccess | BUF_ByteAddressBuffer) : BUF_Dynamic, CreateInfo);
+}
+
+static TSharedPtr<TArray<uint16> const, ESPMode::ThreadSafe> GetEdgeMeshIndexTemplate(
+	uint32 const NumSamples, uint32 const NumSides, uint32 const SegmentVertexStride,
+	uint32 const NumSegments)
+{
+	static FCriticalSection CriticalSection;
+	static TMap<uint64, TSharedPtr<TArray<uint16> const, ESPMode::ThreadSafe>> Templates;
+
+	FScopeLock Lock(&CriticalSection);
+
+	uint64 const Key =
+		(uint64(NumSamples) << 48) | (uint64(NumSides) << 32) | uint64(SegmentVertexStride);
+	if (auto const* const Found = Templates.Find(Key))
+	{
+		return *Found;
+	}
+
+	uint32 const NumSegmentIndices = (NumSamples - 1) * NumSides * 6;
+
+	TArray<uint16>* const Indices = new TArray<uint16>();
+	Indices->SetNumUninitialized(NumSegments * NumSegmentIndices);
+	for (uint32 SegmentIdx = 0; SegmentIdx < NumSegments; SegmentIdx++)
+	{
+		WriteSegmentMeshIndices(SegmentIdx * SegmentVertexStride, NumSamples, NumSides,
+								Indices->GetData() + SegmentIdx * NumSegmentIndices);
+	}
+
+	TSharedPtr<TArray<uint16> const, ESPMode::ThreadSafe> const Template = MakeShareable(Indices);
+	Templates.Add(Key, Template);
+	return Template;
+}
+
+FIGVEdgeMeshIndexTemplateBuffer::FIGVEdgeMeshIndexTemplateBuffer(
+	uint32 const InNumSamples, uint32 const InNumSides, uint32 const InSegmentVertexStride)
+	: NumSamples(InNumSamples),
+	  NumSides(InNumSides),
+	  SegmentVertexStride(FMath::Max(InSegmentVertexStride, 1u)),
+	  NumSegmentIndices((InNumSamples - 1) * InNumSides * 6),
+	  // The last segment only needs NumSamples * NumSides of its stride
+	  NumSegments(FMath::Clamp<uint32>(
+		  (MAX_uint16 + 1 - FMath::Min<uint32>(InNumSamples * InNumSides, MAX_uint16 + 1)) /
+				  SegmentVertexStride +
+			  1,
+		  1, 256)),
+	  Indices()
+{
+}
+
+void FIGVEdgeMeshIndexTemplateBuffer::InitRHI()
+{
+	Indices = GetEdgeMeshIndexTemplate(NumSamples, NumSides, SegmentVertexStride, NumSegments);
+	uint32 const Size = sizeof(uint16) * Indices->Num();
+	checkSlow(Size > 0);
+
+	FRHIResourceCreateInfo CreateInfo;
+	IndexBufferRHI = RHICreateIndexBuffer(sizeof(uint16), Size, BUF_Static, CreateInfo);
+
+	void* const Buffer = RHILockIndexBuffer(IndexBufferRHI, 0, Size, RLM_WriteOnly);
+	FMemory::Memcpy(Buffer, Indices->GetData(), Size);
+	RHIUnlockIndexBuffer(IndexBufferRHI);
 }
 
 void FIGVEdgeMeshVertexFactory::Init(FVertexBuffer* VertexBuffer)
@@ -53,14 +116,59 @@ void FIGVEdgeMeshVertexFactory::Init_RenderThread(const FVertexBuffer* VertexBuf
 	SetData(NewData);
 }
 
+void FIGVEdgeMeshUpdate::Reset()
+{
+	SplineRanges.Reset();
+	ControlPoints.Reset();
+	Segments.Reset();
+	Splines.Reset();
+	bDrawSlotRangeChanged = false;
+	bSlotLODsChanged = false;
+	SlotLODRanges.Reset();
+	SlotLODs.Reset();
+	bChunkBoundsChanged = false;
+	ChunkBoundsRanges.Reset();
+	ChunkBounds.Reset();
+}
+
+// Runs of consecutive dirty chunks, as ranges of the elements they hold
+static void AddDirtyChunkRanges(TBitArray<> const& DirtyChunks, int32 const NumChunkElements,
+								int32 const NumElements, TArray<FIGVEdgeMeshRange>& OutRanges)
+{
+	for (TConstSetBitIterator<> It(DirtyChunks); It; ++It)
+	{
+		int32 const Begin = It.GetIndex() * NumChunkElements;
+		int32 const End = FMath::Min(Begin + NumChunkElements, NumElements);
+		if (OutRanges.Num() > 0 && OutRanges.Last().End == Begin)
+		{
+			OutRanges.Last().End = End;
+		}
+		else
+		{
+			OutRanges.Add(FIGVEdgeMeshRange{Begin, End});
+		}
+	}
+}
+
 FIGVEdgeMeshSceneProxy::~FIGVEdgeMeshSceneProxy()
 {
 	VertexBuffer.ReleaseResource();
 	IndexBuffer.ReleaseResource();
+	for (FIGVEdgeMeshIndexTemplateBuffer& IndexTemplateBuffer : IndexTemplateBuffers)
+	{
+		IndexTemplateBuffer.ReleaseResource();
+	}
 	VertexFactory.ReleaseResource();
 	ReleaseBuffers();
 
 	bIsComputeShaderUnloading = true;
+
+	// Updates still queued for this proxy were applied before it is deleted
+	FIGVEdgeMeshUpdate* Update = nullptr;
+	while (FreeUpdates.Dequeue(Update))
+	{
+		delete Update;
+	}
 }
 
 FIGVEdgeMeshSceneProxy::FIGVEdgeMeshSceneProxy(UIGVEdgeMeshComponent* const Component)
@@ -72,6 +180,26 @@ FIGVEdgeMeshSceneProxy::FIGVEdgeMeshSceneProxy(UIGVEdgeMeshComponent* const Comp
 	  SplineControlPointData(Component->SplineControlPointData),
 	  SplineSegmentData(Component->SplineSegmentData),
 	  SplineData(Component->SplineData),
+	  SplineBeginSegmentIdxs(Component->SplineBeginSegmentIdxs),
+
+	  PendingSplineRanges(),
+	  bFullUploadRequired(true),
+	  FreeUpdates(),
+	  NumQueuedUpdates(),
+
+	  NumSegmentVertices(Component->LayoutNumSegmentSamples * Component->LayoutNumSides),
+	  NumSegmentIndices(
+		  Component->bLayoutUsesIndexTemplate
+			  ? 0
+			  : (Component->LayoutNumSegmentSamples - 1) * Component->LayoutNumSides * 6),
+	  DrawSlotRange(Component->DrawSlotRange),
+	  CachedBatchElements(),
+	  bCachedBatchElementsDirty(true),
+
+	  bCullChunks(Component->GraphActor->bCullEdgeChunks),
+	  ChunkBounds(Component->ChunkBounds),
+	  WorldChunkBounds(),
+	  bWorldChunkBoundsDirty(true),
 
 	  InSplineControlPointBuffer(nullptr),
 	  InSplineSegmentBuffer(nullptr),
@@ -82,11 +210,16 @@ FIGVEdgeMeshSceneProxy::FIGVEdgeMeshSceneProxy(UIGVEdgeMeshComponent* const Comp
 	  InSplineBufferSRV(nullptr),
 	  OutMeshVertexBufferUAV(nullptr),
 
-	  bIsComputeShaderExecuting(false),
 	  bIsComputeShaderUnloading(false),
 
-	  VertexBuffer(Component->NumMeshVertices),
+	  bUseCPUTessellator(UsesCPUTessellator()),
+	  CPUVertices(),
+
+	  VertexBuffer(Component->NumMeshVertices, !bUseCPUTessellator),
 	  IndexBuffer(Component->MeshIndices),
+	  bUseIndexTemplate(Component->bLayoutUsesIndexTemplate),
+	  IndexTemplateBuffers(),
+	  SlotLODs(Component->SlotLODs),
 
 	  Material(Component->GetMaterial(0)),
 	  MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel())),
@@ -97,7 +230,22 @@ FIGVEdgeMeshSceneProxy::FIGVEdgeMeshSceneProxy(UIGVEdgeMeshComponent* const Comp
 {
 	VertexFactory.Init(&VertexBuffer);
 	BeginInitResource(&VertexBuffer);
-	BeginInitResource(&IndexBuffer);
+	if (bUseIndexTemplate)
+	{
+		for (int32 LOD = 0; LOD < UIGVEdgeMeshComponent::NumLODs; LOD++)
+		{
+			FIGVEdgeMeshIndexTemplateBuffer* const IndexTemplateBuffer =
+				new FIGVEdgeMeshIndexTemplateBuffer(
+					GetEdgeLODNumSamples(Component->LayoutNumSegmentSamples, LOD),
+					Component->LayoutNumSides, NumSegmentVertices);
+			IndexTemplateBuffers.Add(IndexTemplateBuffer);
+			BeginInitResource(IndexTemplateBuffer);
+		}
+	}
+	else
+	{
+		BeginInitResource(&IndexBuffer);
+	}
 	BeginInitResource(&VertexFactory);
 
 	if (Material == nullptr)
@@ -106,9 +254,15 @@ FIGVEdgeMeshSceneProxy::FIGVEdgeMeshSceneProxy(UIGVEdgeMeshComponent* const Comp
 		Material = UMaterial::GetDefaultMaterial(MD_Surface);
 	}
 
+	SplineComputeShaderUniformParameters.WorldSize = GraphActor->GetSphereRadius();
+	SplineComputeShaderUniformParameters.Width = GraphActor->EdgeWidth * 0.5;
+	SplineComputeShaderUniformParameters.NumSides = Component->LayoutNumSides;
+
 	if (SplineControlPointData.Num() > 0)
 	{
-		ComputeMesh();
+		ENQUEUE_UNIQUE_RENDER_COMMAND_ONEPARAMETER(
+			FComputeIGVEdgeMesh, FIGVEdgeMeshSceneProxy&, Self, *this,
+			{ Self.ComputeMesh_RenderThread(); });
 	}
 }
 
@@ -116,6 +270,8 @@ void FIGVEdgeMeshSceneProxy::OnTransformChanged()
 {
 	PrimitiveUniformBuffer = CreatePrimitiveUniformBufferImmediate(
 		GetLocalToWorld(), GetBounds(), GetLocalBounds(), true, UseEditorDepthTest());
+	bCachedBatchElementsDirty = true;
+	bWorldChunkBoundsDirty = true;
 }
 
 bool FIGVEdgeMeshSceneProxy::CanBeOccluded() const
@@ -135,22 +291,160 @@ uint32 FIGVEdgeMeshSceneProxy::GetMemoryFootprint() const
 
 void FIGVEdgeMeshSceneProxy::SendRenderDynamicData()
 {
-	SplineControlPointData = IGVEdgeMeshComponent->SplineControlPointData;
-	SplineSegmentData = IGVEdgeMeshComponent->SplineSegmentData;
-	SplineData = IGVEdgeMeshComponent->SplineData;
+	UIGVEdgeMeshComponent const& Component = *IGVEdgeMeshComponent;
+	if (bIsComputeShaderUnloading ||
+		(Component.DirtySplineRanges.Num() == 0 && !Component.bDrawSlotRangeChanged &&
+		 !Component.bSlotLODsChanged && !Component.bChunkBoundsChanged))
+	{
+		return;
+	}
 
-	// TODO: is this required code?
-	IndexBuffer.Indices = IGVEdgeMeshComponent->MeshIndices;
+	// Same layout as the component, so only the dirty splines, their segments and control points
+	// are packed
+	check(SplineData.Num() == Component.SplineData.Num());
 
-	ENQUEUE_UNIQUE_RENDER_COMMAND_ONEPARAMETER(FSendIGVEdgeMeshSceneProxyDynamicData,
-											   FIGVEdgeMeshSceneProxy&, Self, *this,
-											   { Self.SendRenderDynamicData_RenderThread(); });
+	FIGVEdgeMeshUpdate* Update = nullptr;
+	if (!FreeUpdates.Dequeue(Update))
+	{
+		Update = new FIGVEdgeMeshUpdate();
+	}
+	Update->Reset();
 
-	ComputeMesh();
+	for (FIGVEdgeMeshRange const& Range : Component.DirtySplineRanges)
+	{
+		Update->Splines.Append(Component.SplineData.GetData() + Range.Begin,
+							   Range.End - Range.Begin);
+
+		FIGVEdgeSplineData const& LastSpline = Component.SplineData[Range.End - 1];
+		uint32 const BeginControlPointIdx = Component.SplineData[Range.Begin].BeginControlPointIdx;
+		uint32 const EndControlPointIdx =
+			LastSpline.BeginControlPointIdx + LastSpline.NumControlPoints;
+		Update->ControlPoints.Append(
+			Component.SplineControlPointData.GetData() + BeginControlPointIdx,
+			EndControlPointIdx - BeginControlPointIdx);
+
+		// Segments move between slots when edges change their render group
+		int32 const BeginSegmentIdx = SplineBeginSegmentIdxs[Range.Begin];
+		int32 const EndSegmentIdx = Range.End < SplineBeginSegmentIdxs.Num()
+										? SplineBeginSegmentIdxs[Range.End]
+										: Component.SplineSegmentData.Num();
+		Update->Segments.Append(Component.SplineSegmentData.GetData() + BeginSegmentIdx,
+								EndSegmentIdx - BeginSegmentIdx);
+
+		Update->SplineRanges.Add(Range);
+	}
+
+	Update->Parameters.WorldSize = GraphActor->GetSphereRadius();
+	Update->Parameters.Width = GraphActor->EdgeWidth * 0.5;
+	Update->Parameters.NumSides = Component.LayoutNumSides;
+
+	Update->bDrawSlotRangeChanged = Component.bDrawSlotRangeChanged;
+	Update->DrawSlotRange = Component.DrawSlotRange;
+
+	// Only the chunks changed since the last flush
+	Update->bSlotLODsChanged = Component.bSlotLODsChanged;
+	if (Component.bSlotLODsChanged)
+	{
+		AddDirtyChunkRanges(Component.SlotLODDirtyChunks, UIGVEdgeMeshComponent::NumChunkSlots,
+							Component.SlotLODs.Num(), Update->SlotLODRanges);
+		for (FIGVEdgeMeshRange const& Range : Update->SlotLODRanges)
+		{
+			Update->SlotLODs.Append(Component.SlotLODs.GetData() + Range.Begin,
+									Range.End - Range.Begin);
+		}
+	}
+
+	Update->bChunkBoundsChanged = Component.bChunkBoundsChanged;
+	if (Component.bChunkBoundsChanged)
+	{
+		AddDirtyChunkRanges(Component.BoundsDirtyChunks, 1, Component.ChunkBounds.Num(),
+							Update->ChunkBoundsRanges);
+		for (FIGVEdgeMeshRange const& Range : Update->ChunkBoundsRanges)
+		{
+			Update->ChunkBounds.Append(Component.ChunkBounds.GetData() + Range.Begin,
+									   Range.End - Range.Begin);
+		}
+	}
+
+	NumQueuedUpdates.Increment();
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FApplyIGVEdgeMeshUpdate, FIGVEdgeMeshSceneProxy&, Self, *this, FIGVEdgeMeshUpdate*, Update,
+		Update, { Self.ApplyUpdate_RenderThread(Update); });
 }
 
-void FIGVEdgeMeshSceneProxy::SendRenderDynamicData_RenderThread()
+void FIGVEdgeMeshSceneProxy::ApplyUpdate_RenderThread(FIGVEdgeMeshUpdate* const Update)
 {
+	check(IsInRenderingThread());
+
+	int32 ControlPointIdx = 0;
+	int32 SegmentIdx = 0;
+	int32 SplineIdx = 0;
+	for (FIGVEdgeMeshRange const& Range : Update->SplineRanges)
+	{
+		int32 const NumSplines = Range.End - Range.Begin;
+		FMemory::Memcpy(SplineData.GetData() + Range.Begin, Update->Splines.GetData() + SplineIdx,
+						sizeof(FIGVEdgeSplineData) * NumSplines);
+		SplineIdx += NumSplines;
+
+		FIGVEdgeSplineData const& LastSpline = SplineData[Range.End - 1];
+		uint32 const BeginControlPointIdx = SplineData[Range.Begin].BeginControlPointIdx;
+		int32 const NumControlPoints =
+			LastSpline.BeginControlPointIdx + LastSpline.NumControlPoints - BeginControlPointIdx;
+		FMemory::Memcpy(SplineControlPointData.GetData() + BeginControlPointIdx,
+						Update->ControlPoints.GetData() + ControlPointIdx,
+						sizeof(FIGVEdgeSplineControlPointData) * NumControlPoints);
+		ControlPointIdx += NumControlPoints;
+
+		int32 const BeginSegmentIdx = SplineBeginSegmentIdxs[Range.Begin];
+		int32 const EndSegmentIdx = Range.End < SplineBeginSegmentIdxs.Num()
+										? SplineBeginSegmentIdxs[Range.End]
+										: SplineSegmentData.Num();
+		FMemory::Memcpy(SplineSegmentData.GetData() + BeginSegmentIdx,
+						Update->Segments.GetData() + SegmentIdx,
+						sizeof(FIGVEdgeSplineSegmentData) * (EndSegmentIdx - BeginSegmentIdx));
+		SegmentIdx += EndSegmentIdx - BeginSegmentIdx;
+	}
+	PendingSplineRanges.Append(Update->SplineRanges);
+	SplineComputeShaderUniformParameters = Update->Parameters;
+
+	if (Update->bDrawSlotRangeChanged)
+	{
+		DrawSlotRange = Update->DrawSlotRange;
+		bCachedBatchElementsDirty = true;
+	}
+
+	if (Update->bSlotLODsChanged)
+	{
+		int32 PackedIdx = 0;
+		for (FIGVEdgeMeshRange const& Range : Update->SlotLODRanges)
+		{
+			FMemory::Memcpy(SlotLODs.GetData() + Range.Begin, Update->SlotLODs.GetData() + PackedIdx,
+							sizeof(uint8) * (Range.End - Range.Begin));
+			PackedIdx += Range.End - Range.Begin;
+		}
+		bCachedBatchElementsDirty = true;
+	}
+
+	if (Update->bChunkBoundsChanged)
+	{
+		int32 PackedIdx = 0;
+		for (FIGVEdgeMeshRange const& Range : Update->ChunkBoundsRanges)
+		{
+			FMemory::Memcpy(ChunkBounds.GetData() + Range.Begin,
+							Update->ChunkBounds.GetData() + PackedIdx,
+							sizeof(FBox) * (Range.End - Range.Begin));
+			PackedIdx += Range.End - Range.Begin;
+		}
+		bWorldChunkBoundsDirty = true;
+	}
+
+	FreeUpdates.Enqueue(Update);
+
+	// Latest wins: a queued update dispatches for these ranges as well
+	if (NumQueuedUpdates.Decrement() == 0 && PendingSplineRanges.Num() > 0)
+	{
+		ComputeMesh_RenderThread();
+	}
 }
 
 void FIGVEdgeMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
@@ -168,53 +462,29 @@ void FIGVEdgeMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneVie
 
 			if (VertexBuffer.NumElements > 0)
 			{
-				if (RenderGroup == EIGVEdgeRenderGroup::Default)
-				{
-					for (FIGVEdge& Edge : GraphActor->Edges)
-					{
-						if (Edge.RenderGroup == RenderGroup)
-						{
-							FMeshBatch& Mesh = Collector.AllocateMesh();
-							SetMesh(Mesh, bWireframe);
-							SetMeshBatchElement(Mesh.Elements[0], &Edge.MeshData);
-							Collector.AddMesh(ViewIndex, Mesh);
-						}
-					}
-				}
-				else
+				// The group is one slot range rather than one batch per edge
+				FMeshBatch& Mesh = Collector.AllocateMesh();
+				int32 const NumBatchElements =
+					bCullChunks ? SetVisibleMeshBatchElements(Mesh, bWireframe, *View)
+								: SetMeshBatchElements(Mesh, bWireframe);
+				if (NumBatchElements > 0)
 				{
-					FMeshBatch& Mesh = Collector.AllocateMesh();
-					if (SetMeshBatchElements(Mesh, bWireframe))
-					{
-						Collector.AddMesh(ViewIndex, Mesh);
-					}
+					Collector.AddMesh(ViewIndex, Mesh);
 				}
 			}
 		}
 	}
 }
 
-void FIGVEdgeMeshSceneProxy::DrawStaticElements(FStaticPrimitiveDrawInterface* PDI)
-{
-	if (VertexBuffer.NumElements > 0)
-	{
-		FMeshBatch Mesh;
-		if (SetMeshBatchElements(Mesh, false) > 0)
-		{
-			PDI->DrawMesh(Mesh, FLT_MAX);
-		}
-	}
-}
-
 FPrimitiveViewRelevance FIGVEdgeMeshSceneProxy::GetViewRelevance(const FSceneView* View) const
 {
 	FPrimitiveViewRelevance Result;
 	Result.bDrawRelevance = VertexBuffer.NumElements > 0 && IsShown(View);
 	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
 	Result.bShadowRelevance = IsShadowCast(View);
-	Result.bDynamicRelevance = RenderGroup == EIGVEdgeRenderGroup::Default;
-	// Result.bDynamicRelevance = View->Family->EngineShowFlags.Wireframe || IsSelected();
-	Result.bStaticRelevance = !Result.bDynamicRelevance;
+	// Every group changes its slot levels and draw range without a new proxy, which cached static
+	// batches would not pick up
+	Result.bDynamicRelevance = true;
 	MaterialRelevance.SetPrimitiveViewRelevance(Result);
 	return Result;
 }
@@ -235,64 +505,146 @@ int32 FIGVEdgeMeshSceneProxy::SetMeshBatchElements(FMeshBatch& Mesh, bool const
 {
 	SetMesh(Mesh, bWireframe);
 
-	int32 NumBatchElement = 0;
-
-	if (RenderGroup == EIGVEdgeRenderGroup::Default)
+	if (bCachedBatchElementsDirty)
 	{
-		FMeshBatchElement* BatchElement = nullptr;
+		UpdateCachedBatchElements();
+	}
 
-		for (FIGVEdge& Edge : GraphActor->Edges)
+	Mesh.Elements.Reset();
+	Mesh.Elements.Append(CachedBatchElements);
+	return Mesh.Elements.Num();
+}
+
+int32 FIGVEdgeMeshSceneProxy::SetVisibleMeshBatchElements(FMeshBatch& Mesh,
+														  bool const bWireframe,
+														  FSceneView const& View) const
+{
+	if (bWorldChunkBoundsDirty)
+	{
+		FMatrix const& LocalToWorld = GetLocalToWorld();
+		WorldChunkBounds.SetNumUninitialized(ChunkBounds.Num());
+		for (int32 ChunkIdx = 0; ChunkIdx < ChunkBounds.Num(); ChunkIdx++)
 		{
-			// if (Edge.bHidden) continue;
-			if (Edge.RenderGroup == RenderGroup)
-			{
-				FIGVEdgeMeshData& MeshData = Edge.MeshData;
+			WorldChunkBounds[ChunkIdx] = ChunkBounds[ChunkIdx].TransformBy(LocalToWorld);
+		}
+		bWorldChunkBoundsDirty = false;
+	}
 
-				if (BatchElement == nullptr)
-				{
-					BatchElement = (NumBatchElement > 0) ? (new (Mesh.Elements) FMeshBatchElement)
-														 : &Mesh.Elements[0];
-					SetMeshBatchElement(*BatchElement, &MeshData);
-					NumBatchElement++;
-				}
-				else
-				{
-					BatchElement->NumPrimitives += MeshData.IndexBufferSize[RenderGroup] / 3;
-					BatchElement->MaxVertexIndex += MeshData.IndexBufferSize[RenderGroup];
-				}
-			}
-			else
+	// Runs of adjacent chunks that intersect the view frustum
+	TArray<FIGVEdgeMeshRange, TInlineAllocator<16>> SlotRanges;
+
+	int32 const NumChunkSlots = UIGVEdgeMeshComponent::NumChunkSlots;
+	int32 const BeginChunkIdx = DrawSlotRange.Begin / NumChunkSlots;
+	int32 const EndChunkIdx = FMath::DivideAndRoundUp(DrawSlotRange.End, NumChunkSlots);
+
+	for (int32 ChunkIdx = BeginChunkIdx; ChunkIdx < EndChunkIdx; ChunkIdx++)
+	{
+		if (WorldChunkBounds.IsValidIndex(ChunkIdx))
+		{
+			FBox const& Bounds = WorldChunkBounds[ChunkIdx];
+			if (!Bounds.IsValid ||
+				!View.ViewFrustum.IntersectBox(Bounds.GetCenter(), Bounds.GetExtent()))
 			{
-				BatchElement = nullptr;
+				continue;
 			}
 		}
+
+		int32 const BeginSlotIdx = FMath::Max(ChunkIdx * NumChunkSlots, DrawSlotRange.Begin);
+		int32 const EndSlotIdx = FMath::Min((ChunkIdx + 1) * NumChunkSlots, DrawSlotRange.End);
+		if (SlotRanges.Num() > 0 && SlotRanges.Last().End == BeginSlotIdx)
+		{
+			SlotRanges.Last().End = EndSlotIdx;
+		}
+		else
+		{
+			SlotRanges.Add(FIGVEdgeMeshRange{BeginSlotIdx, EndSlotIdx});
+		}
 	}
-	else
+
+	// Nothing culled: the cached elements cover the same range
+	if (SlotRanges.Num() == 1 && SlotRanges[0] == DrawSlotRange)
 	{
-		FMeshBatchElement& BatchElement = Mesh.Elements[0];
-		BatchElement.IndexBuffer = &IndexBuffer;
-		BatchElement.PrimitiveUniformBuffer = PrimitiveUniformBuffer;
-		BatchElement.FirstIndex = 0;
-		BatchElement.NumPrimitives = IndexBuffer.NumElements / 3;
-		BatchElement.MinVertexIndex = 0;
-		BatchElement.MaxVertexIndex = VertexBuffer.NumElements - 1;
-		NumBatchElement++;
+		return SetMeshBatchElements(Mesh, bWireframe);
 	}
 
-	return NumBatchElement;
+	SetMesh(Mesh, bWireframe);
+	Mesh.Elements.Reset();
+	for (FIGVEdgeMeshRange const& SlotRange : SlotRanges)
+	{
+		AddBatchElements(SlotRange, Mesh.Elements);
+	}
+	return Mesh.Elements.Num();
 }
 
-void FIGVEdgeMeshSceneProxy::SetMeshBatchElement(FMeshBatchElement& BatchElement,
-												 FIGVEdgeMeshData* const MeshData) const
+void FIGVEdgeMeshSceneProxy::UpdateCachedBatchElements() const
 {
-	BatchElement.IndexBuffer = &IndexBuffer;
-	BatchElement.PrimitiveUniformBuffer = PrimitiveUniformBuffer;
-
-	BatchElement.FirstIndex = MeshData->IndexBufferOffset[RenderGroup];
-	BatchElement.NumPrimitives = MeshData->IndexBufferSize[RenderGroup] / 3;
-	BatchElement.MinVertexIndex = MeshData->VertexBufferOffset[RenderGroup];
-	BatchElement.MaxVertexIndex =
-		MeshData->VertexBufferOffset[RenderGroup] + MeshData->VertexBufferSize[RenderGroup] - 1;
+	check(IsInRenderingThread());
+
+	CachedBatchElements.Reset();
+	bCachedBatchElementsDirty = false;
+
+	if (DrawSlotRange.End > DrawSlotRange.Begin)
+	{
+		AddBatchElements(DrawSlotRange, CachedBatchElements);
+	}
+}
+
+template <typename AllocatorType>
+void FIGVEdgeMeshSceneProxy::AddBatchElements(
+	FIGVEdgeMeshRange const& SlotRange,
+	TArray<FMeshBatchElement, AllocatorType>& OutBatchElements) const
+{
+	if (SlotRange.Begin == SlotRange.End) return;
+
+	// Slots are ordered by level within chunks, so runs are long
+	int32 RunBeginSlotIdx = SlotRange.Begin;
+	for (int32 SlotIdx = SlotRange.Begin + 1; SlotIdx <= SlotRange.End; SlotIdx++)
+	{
+		int32 const LOD = SlotLODs[RunBeginSlotIdx];
+		if (SlotIdx == SlotRange.End || SlotLODs[SlotIdx] != LOD)
+		{
+			AddLODBatchElements(FIGVEdgeMeshRange{RunBeginSlotIdx, SlotIdx}, LOD, OutBatchElements);
+			RunBeginSlotIdx = SlotIdx;
+		}
+	}
+}
+
+template <typename AllocatorType>
+void FIGVEdgeMeshSceneProxy::AddLODBatchElements(
+	FIGVEdgeMeshRange const& SlotRange, int32 const LOD,
+	TArray<FMeshBatchElement, AllocatorType>& OutBatchElements) const
+{
+	uint32 const NumSlots = SlotRange.End - SlotRange.Begin;
+
+	if (!bUseIndexTemplate)
+	{
+		FMeshBatchElement& BatchElement = OutBatchElements[OutBatchElements.AddDefaulted()];
+		BatchElement.IndexBuffer = &IndexBuffer;
+		BatchElement.PrimitiveUniformBuffer = PrimitiveUniformBuffer;
+		BatchElement.FirstIndex = SlotRange.Begin * NumSegmentIndices;
+		BatchElement.NumPrimitives = NumSlots * NumSegmentIndices / 3;
+		BatchElement.MinVertexIndex = SlotRange.Begin * NumSegmentVertices;
+		BatchElement.MaxVertexIndex = SlotRange.End * NumSegmentVertices - 1;
+		return;
+	}
+
+	FIGVEdgeMeshIndexTemplateBuffer const& IndexTemplateBuffer = IndexTemplateBuffers[LOD];
+
+	// At most one template worth of segments per element
+	for (uint32 SlotIdx = 0; SlotIdx < NumSlots; SlotIdx += IndexTemplateBuffer.NumSegments)
+	{
+		uint32 const NumElementSegments =
+			FMath::Min(IndexTemplateBuffer.NumSegments, NumSlots - SlotIdx);
+
+		FMeshBatchElement& BatchElement = OutBatchElements[OutBatchElements.AddDefaulted()];
+		BatchElement.IndexBuffer = &IndexTemplateBuffer;
+		BatchElement.PrimitiveUniformBuffer = PrimitiveUniformBuffer;
+		BatchElement.FirstIndex = 0;
+		BatchElement.NumPrimitives = NumElementSegments * IndexTemplateBuffer.NumSegmentIndices / 3;
+		BatchElement.BaseVertexIndex = (SlotRange.Begin + SlotIdx) * NumSegmentVertices;
+		BatchElement.MinVertexIndex = 0;
+		BatchElement.MaxVertexIndex = NumElementSegments * NumSegmentVertices - 1;
+	}
 }
 
 void FIGVEdgeMeshSceneProxy::ReleaseBuffers()
@@ -372,53 +724,80 @@ void FIGVEdgeMeshSceneProxy::CreateBuffers()
 	}
 }
 
-void FIGVEdgeMeshSceneProxy::ComputeMesh()
+template <typename ElementType>
+static void UploadStructuredBufferRange(FStructuredBufferRHIRef const& Buffer,
+										TArray<ElementType> const& Data, int32 const Begin,
+										int32 const Num)
 {
-	if (bIsComputeShaderUnloading || bIsComputeShaderExecuting)
-	{
-		return;
-	}
-
-	bIsComputeShaderExecuting = true;
-
-	SplineComputeShaderUniformParameters.WorldSize = GraphActor->GetSphereRadius();
-	SplineComputeShaderUniformParameters.Width = GraphActor->EdgeWidth * 0.5;
-	SplineComputeShaderUniformParameters.NumSides = GraphActor->EdgeNumSides;
+	if (Num == 0) return;
 
-	ENQUEUE_UNIQUE_RENDER_COMMAND_ONEPARAMETER(FSendIGVEdgeMeshDynamicData, FIGVEdgeMeshSceneProxy&,
-											   Self, *this, { Self.ComputeMesh_RenderThread(); });
+	uint32 const ByteSize = sizeof(ElementType) * Num;
+	void* const Dest =
+		RHILockStructuredBuffer(Buffer, sizeof(ElementType) * Begin, ByteSize, RLM_WriteOnly);
+	FMemory::Memcpy(Dest, Data.GetData() + Begin, ByteSize);
+	RHIUnlockStructuredBuffer(Buffer);
 }
 
 void FIGVEdgeMeshSceneProxy::ComputeMesh_RenderThread()
 {
 	check(IsInRenderingThread());
 
+	if (bIsComputeShaderUnloading) return;
+
+	bool const bFullUpload = bFullUploadRequired;
+	TArray<FIGVEdgeMeshRange> const SplineRanges = MoveTemp(PendingSplineRanges);
+	bFullUploadRequired = false;
+
+	if (bUseCPUTessellator)
+	{
+		TessellateMesh_RenderThread(bFullUpload, SplineRanges);
+		return;
+	}
+
 	CreateBuffers();
 
-	uint32 const SplineControlPointBufferByteSize =
-		sizeof(FIGVEdgeSplineControlPointData) * SplineControlPointData.Num();
-	uint32 const SplineSegmentBufferByteSize =
-		sizeof(FIGVEdgeSplineSegmentData) * SplineSegmentData.Num();
-	uint32 const SplineBufferByteSize = sizeof(FIGVEdgeSplineData) * SplineData.Num();
+	int32 NumDispatchSegments = 0;
 
-	// Spline Control Points
-	void* SplineControlPointBuffer = RHILockStructuredBuffer(
-		InSplineControlPointBuffer, 0, SplineControlPointBufferByteSize, RLM_WriteOnly);
-	FMemory::Memcpy(SplineControlPointBuffer, SplineControlPointData.GetData(),
-					SplineControlPointBufferByteSize);
-	RHIUnlockStructuredBuffer(InSplineControlPointBuffer);
-
-	// Spline Segments
-	void* SplineSegmentBuffer = RHILockStructuredBuffer(InSplineSegmentBuffer, 0,
-														SplineSegmentBufferByteSize, RLM_WriteOnly);
-	FMemory::Memcpy(SplineSegmentBuffer, SplineSegmentData.GetData(), SplineSegmentBufferByteSize);
-	RHIUnlockStructuredBuffer(InSplineSegmentBuffer);
-
-	// Spline
-	void* SplineBuffer =
-		RHILockStructuredBuffer(InSplineBuffer, 0, SplineBufferByteSize, RLM_WriteOnly);
-	FMemory::Memcpy(SplineBuffer, SplineData.GetData(), SplineBufferByteSize);
-	RHIUnlockStructuredBuffer(InSplineBuffer);
+	if (bFullUpload)
+	{
+		UploadStructuredBufferRange(InSplineControlPointBuffer, SplineControlPointData, 0,
+									SplineControlPointData.Num());
+		UploadStructuredBufferRange(InSplineSegmentBuffer, SplineSegmentData, 0,
+									SplineSegmentData.Num());
+		UploadStructuredBufferRange(InSplineBuffer, SplineData, 0, SplineData.Num());
+		NumDispatchSegments = SplineSegmentData.Num();
+	}
+	else
+	{
+		// Segments carry absolute offsets, so the segment buffer only needs to list the segments
+		// of the changed splines; the rest of the mesh stays as it is
+		TArray<FIGVEdgeSplineSegmentData> DispatchSegmentData;
+
+		for (FIGVEdgeMeshRange const& Range : SplineRanges)
+		{
+			FIGVEdgeSplineData const& LastSpline = SplineData[Range.End - 1];
+			uint32 const BeginControlPointIdx = SplineData[Range.Begin].BeginControlPointIdx;
+			uint32 const EndControlPointIdx =
+				LastSpline.BeginControlPointIdx + LastSpline.NumControlPoints;
+			UploadStructuredBufferRange(InSplineControlPointBuffer, SplineControlPointData,
+										BeginControlPointIdx,
+										EndControlPointIdx - BeginControlPointIdx);
+
+			UploadStructuredBufferRange(InSplineBuffer, SplineData, Range.Begin,
+										Range.End - Range.Begin);
+
+			int32 const BeginSegmentIdx = SplineBeginSegmentIdxs[Range.Begin];
+			int32 const EndSegmentIdx = Range.End < SplineBeginSegmentIdxs.Num()
+											? SplineBeginSegmentIdxs[Range.End]
+											: SplineSegmentData.Num();
+			DispatchSegmentData.Append(SplineSegmentData.GetData() + BeginSegmentIdx,
+									   EndSegmentIdx - BeginSegmentIdx);
+		}
+
+		UploadStructuredBufferRange(InSplineSegmentBuffer, DispatchSegmentData, 0,
+									DispatchSegmentData.Num());
+		NumDispatchSegments = DispatchSegmentData.Num();
+	}
 
 	// Compute Shader
 	if (bIsComputeShaderUnloading)
@@ -436,8 +815,69 @@ void FIGVEdgeMeshSceneProxy::ComputeMesh_RenderThread()
 	ComputeShader->SetBuffers(RHICmdList, InSplineControlPointBufferSRV, InSplineSegmentBufferSRV,
 							  InSplineBufferSRV, OutMeshVertexBufferUAV);
 	ComputeShader->SetUniformBuffers(RHICmdList, SplineComputeShaderUniformParameters);
-	DispatchComputeShader(RHICmdList, *ComputeShader, SplineSegmentData.Num(), 1, 1);
+	DispatchComputeShader(RHICmdList, *ComputeShader, NumDispatchSegments, 1, 1);
 	ComputeShader->UnbindBuffers(RHICmdList);
+}
+
+bool FIGVEdgeMeshSceneProxy::UsesCPUTessellator()
+{
+	return GUsingNullRHI || !RHISupportsComputeShaders(GMaxRHIShaderPlatform);
+}
+
+void FIGVEdgeMeshSceneProxy::TessellateMesh_RenderThread(
+	bool const bFullUpload, TArray<FIGVEdgeMeshRange> const& SplineRanges)
+{
+	check(IsInRenderingThread());
+
+	if (bIsComputeShaderUnloading || VertexBuffer.NumElements == 0) return;
+
+	FIGVEdgeMeshTessellator const Tessellator(SplineControlPointData, SplineData,
+											  SplineComputeShaderUniformParameters);
+	uint32 const NumSides = SplineComputeShaderUniformParameters.NumSides;
+
+	auto TessellateSegments = [&](int32 const BeginSegmentIdx, int32 const EndSegmentIdx) {
+		if (BeginSegmentIdx == EndSegmentIdx) return;
+
+		TArrayView<FIGVEdgeSplineSegmentData const> const Segments(
+			SplineSegmentData.GetData() + BeginSegmentIdx, EndSegmentIdx - BeginSegmentIdx);
+		Tessellator.Tessellate(Segments, CPUVertices.GetData());
+
+		// Segments sit in slots ordered by render group, so upload runs of adjacent slots
+		int32 RunBeginIdx = 0;
+		for (int32 Idx = 1; Idx <= Segments.Num(); Idx++)
+		{
+			FIGVEdgeSplineSegmentData const& Last = Segments[Idx - 1];
+			uint32 const EndVertexIdx = Last.MeshVertexBufferOffset + Last.NumSamples * NumSides;
+			if (Idx < Segments.Num() && Segments[Idx].MeshVertexBufferOffset == EndVertexIdx)
+			{
+				continue;
+			}
+
+			uint32 const BeginVertexIdx = Segments[RunBeginIdx].MeshVertexBufferOffset;
+			uint32 const ByteSize = sizeof(FDynamicMeshVertex) * (EndVertexIdx - BeginVertexIdx);
+
+			void* const Dest = RHILockVertexBuffer(VertexBuffer.VertexBufferRHI,
+												   sizeof(FDynamicMeshVertex) * BeginVertexIdx,
+												   ByteSize, RLM_WriteOnly);
+			FMemory::Memcpy(Dest, CPUVertices.GetData() + BeginVertexIdx, ByteSize);
+			RHIUnlockVertexBuffer(VertexBuffer.VertexBufferRHI);
+
+			RunBeginIdx = Idx;
+		}
+	};
 
-	bIsComputeShaderExecuting = false;
+	if (bFullUpload || CPUVertices.Num() != VertexBuffer.NumElements)
+	{
+		CPUVertices.SetNumZeroed(VertexBuffer.NumElements);
+		TessellateSegments(0, SplineSegmentData.Num());
+		return;
+	}
+
+	for (FIGVEdgeMeshRange const& Range : SplineRanges)
+	{
+		TessellateSegments(SplineBeginSegmentIdxs[Range.Begin],
+						   Range.End < SplineBeginSegmentIdxs.Num()
+							   ? SplineBeginSegmentIdxs[Range.End]
+							   : SplineSegmentData.Num());
+	}
 }
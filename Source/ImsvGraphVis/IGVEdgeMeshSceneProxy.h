@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Containers/Queue.h"
+
 #include "KWMeshElement.h"
 #include "SplineComputeShader.h"
 
@@ -12,9 +14,31 @@ class IMSVGRAPHVIS_API FIGVEdgeMeshVertexBuffer : public FVertexBuffer
 {
 public:
 	int32 const NumElements;
+	bool const bUnorderedAccess;  // Written by the compute shader rather than locked
+
+	FIGVEdgeMeshVertexBuffer(int32 const InNumElements, bool const bInUnorderedAccess);
+	virtual void InitRHI() override;
+};
 
-	FIGVEdgeMeshVertexBuffer(int32 const InNumElements);
+// 16-bit indices of a run of consecutive tube segments. Every segment has the same index pattern,
+// so one template per tessellation is shared by all edges and drawn with base vertex offsets.
+// Segments start SegmentVertexStride vertices apart, which is more than NumSamples * NumSides for
+// the reduced levels of detail.
+class IMSVGRAPHVIS_API FIGVEdgeMeshIndexTemplateBuffer : public FIndexBuffer
+{
+public:
+	uint32 const NumSamples;
+	uint32 const NumSides;
+	uint32 const SegmentVertexStride;
+	uint32 const NumSegmentIndices;
+	uint32 const NumSegments;
+
+	FIGVEdgeMeshIndexTemplateBuffer(uint32 const NumSamples, uint32 const NumSides,
+									uint32 const SegmentVertexStride);
 	virtual void InitRHI() override;
+
+private:
+	TSharedPtr<TArray<uint16> const, ESPMode::ThreadSafe> Indices;
 };
 
 class IMSVGRAPHVIS_API FIGVEdgeMeshVertexFactory : public FLocalVertexFactory
@@ -24,6 +48,33 @@ public:
 	void Init_RenderThread(const FVertexBuffer* VertexBuffer);
 };
 
+// Changes of an edge mesh component for its scene proxy. The dirty splines, their control points
+// and segments are packed in the order of SplineRanges; the other members are only valid when
+// their flag is set.
+struct IMSVGRAPHVIS_API FIGVEdgeMeshUpdate
+{
+	TArray<FIGVEdgeMeshRange> SplineRanges;
+	TArray<FIGVEdgeSplineControlPointData> ControlPoints;
+	TArray<FIGVEdgeSplineSegmentData> Segments;
+	TArray<FIGVEdgeSplineData> Splines;
+	FSplineComputeShaderUniformParameters Parameters;
+
+	bool bDrawSlotRangeChanged;
+	FIGVEdgeMeshRange DrawSlotRange;
+
+	// Levels of the slots of the dirty chunks, packed in the order of SlotLODRanges
+	bool bSlotLODsChanged;
+	TArray<FIGVEdgeMeshRange> SlotLODRanges;
+	TArray<uint8> SlotLODs;
+
+	// Bounds of the dirty chunks, packed in the order of ChunkBoundsRanges (of chunks)
+	bool bChunkBoundsChanged;
+	TArray<FIGVEdgeMeshRange> ChunkBoundsRanges;
+	TArray<FBox> ChunkBounds;
+
+	void Reset();  // Keeps the allocations
+};
+
 class IMSVGRAPHVIS_API FIGVEdgeMeshSceneProxy : public FPrimitiveSceneProxy
 {
 public:
@@ -34,6 +85,33 @@ public:
 	TArray<FIGVEdgeSplineControlPointData> SplineControlPointData;
 	TArray<FIGVEdgeSplineSegmentData> SplineSegmentData;
 	TArray<FIGVEdgeSplineData> SplineData;
+	TArray<int32> SplineBeginSegmentIdxs;
+
+	// Splines changed since the last dispatch. The first dispatch uploads everything; the layout
+	// cannot change afterwards, since the component then recreates the proxy.
+	TArray<FIGVEdgeMeshRange> PendingSplineRanges;
+	bool bFullUploadRequired;
+
+	// The arrays above belong to the render thread. Changes are packed into updates, which are
+	// handed over by pointer and returned to FreeUpdates once applied, so there are usually three
+	// in use: one being packed, one queued and one being applied. Every update is applied, but
+	// only the last of a queued series dispatches, for the ranges of all of them.
+	TQueue<FIGVEdgeMeshUpdate*, EQueueMode::Spsc> FreeUpdates;
+	FThreadSafeCounter NumQueuedUpdates;
+
+	// Segment slots to draw (see UIGVEdgeMeshComponent::DrawSlotRange) and their batch elements,
+	// rebuilt on the render thread only when the range or the uniform buffer change
+	uint32 const NumSegmentVertices;
+	uint32 const NumSegmentIndices;
+	FIGVEdgeMeshRange DrawSlotRange;
+	mutable TArray<FMeshBatchElement> CachedBatchElements;
+	mutable bool bCachedBatchElementsDirty;
+
+	// Chunk bounds of the component, and in world space for culling against each view
+	bool const bCullChunks;
+	TArray<FBox> ChunkBounds;
+	mutable TArray<FBox> WorldChunkBounds;
+	mutable bool bWorldChunkBoundsDirty;
 
 	FStructuredBufferRHIRef InSplineControlPointBuffer;
 	FStructuredBufferRHIRef InSplineSegmentBuffer;
@@ -46,11 +124,18 @@ public:
 
 	FSplineComputeShaderUniformParameters SplineComputeShaderUniformParameters;
 
-	bool bIsComputeShaderExecuting;
 	bool bIsComputeShaderUnloading;
 
+	// Without compute shader support (-nullrhi, headless) the mesh is tessellated on the CPU into
+	// a mirror of the vertex buffer, and only the changed vertex ranges are uploaded
+	bool const bUseCPUTessellator;
+	TArray<FDynamicMeshVertex> CPUVertices;
+
 	FIGVEdgeMeshVertexBuffer VertexBuffer;
 	FResourceArrayIndexBuffer IndexBuffer;
+	bool const bUseIndexTemplate;  // Instead of IndexBuffer
+	TIndirectArray<FIGVEdgeMeshIndexTemplateBuffer> IndexTemplateBuffers;  // One per LOD
+	TArray<uint8> SlotLODs;
 	FIGVEdgeMeshVertexFactory VertexFactory;
 
 	UMaterialInterface* Material;
@@ -71,23 +156,36 @@ public:
 
 public:
 	void SendRenderDynamicData();
-	void SendRenderDynamicData_RenderThread();
+	void ApplyUpdate_RenderThread(FIGVEdgeMeshUpdate* const Update);
 
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
 										const FSceneViewFamily& ViewFamily, uint32 VisibilityMap,
 										class FMeshElementCollector& Collector) const override;
-	virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override;
 	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
 
 	void SetMesh(FMeshBatch& Mesh, bool const bWireframe) const;
 	int32 SetMeshBatchElements(FMeshBatch& Mesh, bool const bWireframe) const;
-	void SetMeshBatchElement(FMeshBatchElement& BatchElement,
-							 FIGVEdgeMeshData* const MeshData) const;
+	int32 SetVisibleMeshBatchElements(FMeshBatch& Mesh, bool const bWireframe,
+									  FSceneView const& View) const;
+	void UpdateCachedBatchElements() const;
+
+	// Splits the range where the level of detail changes
+	template <typename AllocatorType>
+	void AddBatchElements(FIGVEdgeMeshRange const& SlotRange,
+						  TArray<FMeshBatchElement, AllocatorType>& OutBatchElements) const;
+
+	template <typename AllocatorType>
+	void AddLODBatchElements(FIGVEdgeMeshRange const& SlotRange, int32 const LOD,
+							 TArray<FMeshBatchElement, AllocatorType>& OutBatchElements) const;
 
 private:
 	void ReleaseBuffers();
 	void CreateBuffers();
 
-	void ComputeMesh();
 	void ComputeMesh_RenderThread();
+	void TessellateMesh_RenderThread(bool const bFullUpload,
+									 TArray<FIGVEdgeMeshRange> const& SplineRanges);
+
+public:
+	static bool UsesCPUTessellator();
 };
@@ -0,0 +1,196 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVEdgeMeshTessellator.h"
+
+#include "KWColorSpace.h"
+#include "KWTask.h"
+
+FIGVEdgeMeshTessellator::FIGVEdgeMeshTessellator(
+	TArrayView<FIGVEdgeSplineControlPointData const> const InControlPoints,
+	TArrayView<FIGVEdgeSplineData const> const InSplines,
+	FSplineComputeShaderUniformParameters const& InParameters)
+	: ControlPoints(InControlPoints),
+	  Splines(InSplines),
+	  WorldSize(InParameters.WorldSize),
+	  Width(InParameters.Width),
+	  NumSides(InParameters.NumSides),
+	  SideCos(),
+	  SideSin()
+{
+	SideCos.SetNumUninitialized(NumSides);
+	SideSin.SetNumUninitialized(NumSides);
+	for (uint32 SideIdx = 0; SideIdx < NumSides; SideIdx++)
+	{
+		FMath::SinCos(&SideSin[SideIdx], &SideCos[SideIdx], 2 * PI * SideIdx / NumSides);
+	}
+}
+
+void FIGVEdgeMeshTessellator::Tessellate(
+	TArrayView<FIGVEdgeSplineSegmentData const> const Segments,
+	FDynamicMeshVertex* const OutVertices) const
+{
+	// Segments differ in their number of samples, which the chunks even out
+	KWParallelFor(Segments.Num(), [this, &Segments, OutVertices](int32 const Begin,
+																 int32 const End) {
+		for (int32 SegmentIdx = Begin; SegmentIdx < End; SegmentIdx++)
+		{
+			TessellateSegment(Segments[SegmentIdx], OutVertices);
+		}
+	});
+}
+
+void FIGVEdgeMeshTessellator::GetBundledControlPoints(FIGVEdgeSplineSegmentData const& Segment,
+													 VectorRegister* const OutPoints,
+													 float* const OutKnots) const
+{
+	FIGVEdgeSplineData const& Spline = Splines[Segment.SplineIdx];
+	FIGVEdgeSplineControlPointData const& FirstPoint = ControlPoints[Spline.BeginControlPointIdx];
+	FIGVEdgeSplineControlPointData const& LastPoint =
+		ControlPoints[Spline.BeginControlPointIdx + Spline.NumControlPoints - 1];
+	float const KnotRange = FMath::Max(LastPoint.Knot - FirstPoint.Knot, 1e-6f);
+
+	VectorRegister const Start = VectorLoadFloat3(&Spline.StartPosition);
+	VectorRegister const End = VectorLoadFloat3(&Spline.EndPosition);
+	VectorRegister const Strength = VectorSetFloat1(Spline.BundlingStrength);
+	VectorRegister const Scale = VectorSetFloat1(WorldSize);
+
+	for (int32 PointIdx = 0; PointIdx < 4; PointIdx++)
+	{
+		FIGVEdgeSplineControlPointData const& Point =
+			ControlPoints[Segment.BeginControlPointIdx + PointIdx];
+		float const Alpha = (Point.Knot - FirstPoint.Knot) / KnotRange;
+
+		VectorRegister const Straight =
+			VectorMultiplyAdd(VectorSubtract(End, Start), VectorSetFloat1(Alpha), Start);
+		VectorRegister const Curved =
+			VectorMultiply(VectorLoadFloat3(&Point.Position), VectorSetFloat1(Point.Level));
+		VectorRegister const Bundled =
+			VectorMultiplyAdd(VectorSubtract(Curved, Straight), Strength, Straight);
+
+		OutPoints[PointIdx] = VectorMultiply(Bundled, Scale);
+		OutKnots[PointIdx] = Point.Knot;
+	}
+}
+
+FBox FIGVEdgeMeshTessellator::CalcSegmentBounds(FIGVEdgeSplineSegmentData const& Segment,
+												float const RelativeMargin) const
+{
+	VectorRegister Points[4];
+	float Knots[4];
+	GetBundledControlPoints(Segment, Points, Knots);
+
+	VectorRegister const Radius = VectorSetFloat1(Width + RelativeMargin * WorldSize);
+	VectorRegister const Min = VectorSubtract(
+		VectorMin(VectorMin(Points[0], Points[1]), VectorMin(Points[2], Points[3])), Radius);
+	VectorRegister const Max = VectorAdd(
+		VectorMax(VectorMax(Points[0], Points[1]), VectorMax(Points[2], Points[3])), Radius);
+
+	FBox Bounds(ForceInit);
+	VectorStoreFloat3(Min, &Bounds.Min);
+	VectorStoreFloat3(Max, &Bounds.Max);
+	Bounds.IsValid = 1;
+	return Bounds;
+}
+
+float FIGVEdgeMeshTessellator::CalcSegmentCurvature(FIGVEdgeSplineSegmentData const& Segment) const
+{
+	VectorRegister Points[4];
+	float Knots[4];
+	GetBundledControlPoints(Segment, Points, Knots);
+
+	// The second derivative of a cubic B-spline segment is linear between the second differences
+	// of its control points
+	VectorRegister const Two = VectorSetFloat1(2.f);
+	VectorRegister const StartDelta =
+		VectorAdd(VectorSubtract(Points[0], VectorMultiply(Points[1], Two)), Points[2]);
+	VectorRegister const EndDelta =
+		VectorAdd(VectorSubtract(Points[1], VectorMultiply(Points[2], Two)), Points[3]);
+
+	float const StartLengthSquared = VectorGetComponent(VectorDot3(StartDelta, StartDelta), 0);
+	float const EndLengthSquared = VectorGetComponent(VectorDot3(EndDelta, EndDelta), 0);
+	return FMath::Sqrt(FMath::Max(StartLengthSquared, EndLengthSquared));
+}
+
+void FIGVEdgeMeshTessellator::TessellateSegment(FIGVEdgeSplineSegmentData const& Segment,
+												FDynamicMeshVertex* const OutVertices) const
+{
+	FIGVEdgeSplineData const& Spline = Splines[Segment.SplineIdx];
+	float const FirstKnot = ControlPoints[Spline.BeginControlPointIdx].Knot;
+	float const KnotRange = FMath::Max(
+		ControlPoints[Spline.BeginControlPointIdx + Spline.NumControlPoints - 1].Knot - FirstKnot,
+		1e-6f);
+
+	VectorRegister Points[4];
+	float Knots[4];
+	GetBundledControlPoints(Segment, Points, Knots);
+
+	uint32 const NumSamples = Segment.NumSamples;
+	float const SampleStep = 1.f / FMath::Max<uint32>(NumSamples - 1, 1);
+
+	FDynamicMeshVertex* Vertex = OutVertices + Segment.MeshVertexBufferOffset;
+
+	for (uint32 SampleIdx = 0; SampleIdx < NumSamples; SampleIdx++)
+	{
+		float const T = SampleIdx * SampleStep;
+		float const T2 = T * T;
+		float const T3 = T2 * T;
+		float const U = 1 - T;
+
+		// Uniform cubic B-spline basis and its derivative
+		float const B0 = U * U * U / 6;
+		float const B1 = (3 * T3 - 6 * T2 + 4) / 6;
+		float const B2 = (-3 * T3 + 3 * T2 + 3 * T + 1) / 6;
+		float const B3 = T3 / 6;
+
+		float const D0 = -U * U / 2;
+		float const D1 = (3 * T2 - 4 * T) / 2;
+		float const D2 = (-3 * T2 + 2 * T + 1) / 2;
+		float const D3 = T2 / 2;
+
+		VectorRegister Position = VectorMultiply(Points[0], VectorSetFloat1(B0));
+		Position = VectorMultiplyAdd(Points[1], VectorSetFloat1(B1), Position);
+		Position = VectorMultiplyAdd(Points[2], VectorSetFloat1(B2), Position);
+		Position = VectorMultiplyAdd(Points[3], VectorSetFloat1(B3), Position);
+
+		VectorRegister Tangent = VectorMultiply(Points[0], VectorSetFloat1(D0));
+		Tangent = VectorMultiplyAdd(Points[1], VectorSetFloat1(D1), Tangent);
+		Tangent = VectorMultiplyAdd(Points[2], VectorSetFloat1(D2), Tangent);
+		Tangent = VectorMultiplyAdd(Points[3], VectorSetFloat1(D3), Tangent);
+		Tangent = VectorNormalizeSafe(VectorSet_W0(Tangent), GlobalVectorConstants::Float1000);
+
+		// Frame around the tangent, with the normal lying on the sphere
+		VectorRegister const Radial =
+			VectorNormalizeSafe(VectorSet_W0(Position), GlobalVectorConstants::Float0010);
+		VectorRegister const Normal = VectorNormalizeSafe(
+			VectorCross(Tangent, Radial), GlobalVectorConstants::Float0100);
+		VectorRegister const Binormal = VectorCross(Tangent, Normal);
+
+		float const Knot = Knots[0] * B0 + Knots[1] * B1 + Knots[2] * B2 + Knots[3] * B3;
+		float const ColorAlpha = (Knot - FirstKnot) / KnotRange;
+		FColor const Color =
+			FLinearColor(UKWColorSpace::HCLtoRGB(UKWColorSpace::LerpHCL(
+							 Spline.StartColor_HCL, Spline.EndColor_HCL, ColorAlpha)))
+				.ToFColor(false);
+
+		FVector TangentX;
+		VectorStoreFloat3(Tangent, &TangentX);
+
+		for (uint32 SideIdx = 0; SideIdx < NumSides; SideIdx++, Vertex++)
+		{
+			VectorRegister const Offset =
+				VectorMultiplyAdd(Normal, VectorSetFloat1(SideCos[SideIdx]),
+								  VectorMultiply(Binormal, VectorSetFloat1(SideSin[SideIdx])));
+
+			FVector TangentZ;
+			VectorStoreFloat3(Offset, &TangentZ);
+			VectorStoreFloat3(VectorMultiplyAdd(Offset, VectorSetFloat1(Width), Position),
+							  &Vertex->Position);
+
+			Vertex->TextureCoordinate = FVector2D(Knot, float(SideIdx) / NumSides);
+			Vertex->TangentX = TangentX;
+			Vertex->TangentZ = TangentZ;
+			Vertex->TangentZ.Vector.W = 255;
+			Vertex->Color = Color;
+		}
+	}
+}
@@ -0,0 +1,61 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "CoreMinimal.h"
+#include "DynamicMeshBuilder.h"
+#include "SplineComputeShader.h"
+
+#include "IGVEdgeSplineData.h"
+
+// CPU counterpart of FSplineComputeShader_Sphere. It reads the same control point, segment and
+// spline arrays and writes the same vertex layout: NumSamples rings of NumSides vertices per
+// segment, starting at the segment's MeshVertexBufferOffset. Used by the edge mesh scene proxy when
+// compute shaders are unavailable (-nullrhi, headless machines), and as a reference for tests and
+// benchmarks.
+//
+// Each segment is a uniform cubic B-spline over four consecutive control points. Control points are
+// pulled towards the straight line between the end points by the spline's BundlingStrength, and
+// lifted off the sphere by their level.
+class IMSVGRAPHVIS_API FIGVEdgeMeshTessellator
+{
+public:
+	FIGVEdgeMeshTessellator(TArrayView<FIGVEdgeSplineControlPointData const> const InControlPoints,
+							TArrayView<FIGVEdgeSplineData const> const InSplines,
+							FSplineComputeShaderUniformParameters const& InParameters);
+
+	// Tessellates the segments in parallel; OutVertices is indexed like the GPU vertex buffer
+	void Tessellate(TArrayView<FIGVEdgeSplineSegmentData const> const Segments,
+					FDynamicMeshVertex* const OutVertices) const;
+
+	void TessellateSegment(FIGVEdgeSplineSegmentData const& Segment,
+						   FDynamicMeshVertex* const OutVertices) const;
+
+	// Bounds of the tube around the segment: a B-spline lies within the convex hull of its
+	// control points. This models the shader rather than reading back what it draws, so the
+	// bounds are padded by RelativeMargin times the world size.
+	FBox CalcSegmentBounds(FIGVEdgeSplineSegmentData const& Segment,
+						   float const RelativeMargin) const;
+
+	// Largest second derivative of the segment's curve, in world units. Sampling it at n evenly
+	// spaced parameters strays at most Curvature / (8 * (n - 1)^2) from the exact curve.
+	float CalcSegmentCurvature(FIGVEdgeSplineSegmentData const& Segment) const;
+
+private:
+	// The four control points of the segment after bundling, in world units
+	void GetBundledControlPoints(FIGVEdgeSplineSegmentData const& Segment,
+								 VectorRegister* const OutPoints, float* const OutKnots) const;
+
+private:
+	TArrayView<FIGVEdgeSplineControlPointData const> const ControlPoints;
+	TArrayView<FIGVEdgeSplineData const> const Splines;
+
+	float const WorldSize;
+	float const Width;
+	uint32 const NumSides;
+
+	// Ring directions in the normal/binormal plane
+	TArray<float, TInlineAllocator<32>> SideCos;
+	TArray<float, TInlineAllocator<32>> SideSin;
+};
@@ -11,6 +11,15 @@ struct IMSVGRAPHVIS_API FIGVEdgeSplineControlPointData
 	float Knot;
 };
 
+// Inner control point of an edge as kept by FIGVEdgeStore: its position and default level come from
+// the cluster table, its current level from the edge's path levels
+struct IMSVGRAPHVIS_API FIGVEdgeSplineControlPointRef
+{
+	int32 ClusterIdx;
+	int32 PathIdx;
+	float Knot;
+};
+
 struct IMSVGRAPHVIS_API FIGVEdgeSplineSegmentData
 {
 	uint32 SplineIdx;
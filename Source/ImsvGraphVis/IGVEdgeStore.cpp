@@ -0,0 +1,615 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVEdgeStore.h"
+
+#include "IGVCluster.h"
+#include "IGVClusterLCA.h"
+#include "IGVGraphActor.h"
+#include "IGVNodeActor.h"
+#include "KWTask.h"
+
+FIGVEdgeStore::FIGVEdgeStore(AIGVGraphActor* const InGraphActor)
+	: GraphActor(InGraphActor),
+	  Slots(),
+	  Generations(),
+	  SlotDenseIdxs(),
+	  FreeSlots(),
+	  DenseSlots(),
+	  PairIndex(),
+	  PathClusters(),
+	  PathLevels(),
+	  PathLevelsDefault(),
+	  PathLevelsBeforeTransition(),
+	  PathLevelsAfterTransition(),
+	  ControlPoints(),
+	  NumUnusedPathElements(0),
+	  ClusterPositions(),
+	  ClusterLevels()
+{
+}
+
+void FIGVEdgeStore::Empty()
+{
+	Slots.Empty();
+	Generations.Empty();
+	SlotDenseIdxs.Empty();
+	FreeSlots.Empty();
+	DenseSlots.Empty();
+	PairIndex.Empty();
+
+	PathClusters.Empty();
+	PathLevels.Empty();
+	PathLevelsDefault.Empty();
+	PathLevelsBeforeTransition.Empty();
+	PathLevelsAfterTransition.Empty();
+	ControlPoints.Empty();
+	NumUnusedPathElements = 0;
+
+	ClusterPositions.Empty();
+	ClusterLevels.Empty();
+}
+
+FIGVEdgeHandle FIGVEdgeStore::Add(FIGVEdge&& Edge)
+{
+	int32 SlotIdx;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIdx = FreeSlots.Pop(false);
+	}
+	else
+	{
+		SlotIdx = Slots.Add(1);
+		Generations.Add(1);
+		SlotDenseIdxs.Add(INDEX_NONE);
+	}
+
+	FIGVEdge& Slot = Slots[SlotIdx];
+	Slot = MoveTemp(Edge);
+	Slot.StoreSlotIdx = SlotIdx;
+
+	SlotDenseIdxs[SlotIdx] = DenseSlots.Add(SlotIdx);
+	PairIndex.Add(PairKey(Slot.SourceIdx, Slot.TargetIdx), SlotIdx);
+
+	return FIGVEdgeHandle(SlotIdx, Generations[SlotIdx]);
+}
+
+bool FIGVEdgeStore::Remove(FIGVEdgeHandle const Handle)
+{
+	if (!IsValid(Handle)) return false;
+
+	int32 const SlotIdx = Handle.SlotIdx;
+	FIGVEdge& Slot = Slots[SlotIdx];
+
+	ReleasePath(Slot);
+	PairIndex.RemoveSingle(PairKey(Slot.SourceIdx, Slot.TargetIdx), SlotIdx);
+
+	// Swap the last live slot into the hole of the dense list
+	int32 const DenseIdx = SlotDenseIdxs[SlotIdx];
+	DenseSlots.RemoveAtSwap(DenseIdx, 1, false);
+	if (DenseIdx < DenseSlots.Num())
+	{
+		SlotDenseIdxs[DenseSlots[DenseIdx]] = DenseIdx;
+	}
+	SlotDenseIdxs[SlotIdx] = INDEX_NONE;
+
+	Slot = FIGVEdge();
+
+	Generations[SlotIdx]++;
+	FreeSlots.Add(SlotIdx);
+
+	return true;
+}
+
+bool FIGVEdgeStore::IsValid(FIGVEdgeHandle const Handle) const
+{
+	return Generations.IsValidIndex(Handle.SlotIdx) &&
+		   Generations[Handle.SlotIdx] == Handle.Generation &&
+		   SlotDenseIdxs[Handle.SlotIdx] != INDEX_NONE;
+}
+
+FIGVEdge* FIGVEdgeStore::Get(FIGVEdgeHandle const Handle)
+{
+	return IsValid(Handle) ? &Slots[Handle.SlotIdx] : nullptr;
+}
+
+FIGVEdge const* FIGVEdgeStore::Get(FIGVEdgeHandle const Handle) const
+{
+	return IsValid(Handle) ? &Slots[Handle.SlotIdx] : nullptr;
+}
+
+FIGVEdgeHandle FIGVEdgeStore::GetHandle(FIGVEdge const& Edge) const
+{
+	int32 const SlotIdx = Edge.StoreSlotIdx;
+	check(Generations.IsValidIndex(SlotIdx) && &Slots[SlotIdx] == &Edge);
+	return FIGVEdgeHandle(SlotIdx, Generations[SlotIdx]);
+}
+
+FIGVEdgeHandle FIGVEdgeStore::Find(int32 const NodeIdxA, int32 const NodeIdxB) const
+{
+	int32 const* const SlotIdx = PairIndex.Find(PairKey(NodeIdxA, NodeIdxB));
+	return SlotIdx != nullptr ? FIGVEdgeHandle(*SlotIdx, Generations[*SlotIdx]) : FIGVEdgeHandle();
+}
+
+void FIGVEdgeStore::FindAll(int32 const NodeIdxA, int32 const NodeIdxB,
+							TArray<FIGVEdgeHandle>& OutHandles) const
+{
+	TArray<int32> SlotIdxs;
+	PairIndex.MultiFind(PairKey(NodeIdxA, NodeIdxB), SlotIdxs);
+
+	OutHandles.Reset(SlotIdxs.Num());
+	for (int32 const SlotIdx : SlotIdxs)
+	{
+		OutHandles.Emplace(SlotIdx, Generations[SlotIdx]);
+	}
+}
+
+void FIGVEdgeStore::SetupAllClusters()
+{
+	TArray<FIGVCluster>& Clusters = GraphActor->Clusters;
+
+	FIGVClusterLCA LCA;
+	LCA.Build(Clusters, *GraphActor->RootCluster);
+
+	UpdateClusterLevels();
+
+	int32 const NumEdges = Num();
+
+	// Lowest common ancestors and path lengths
+	KWParallelFor(NumEdges, [&](int32 const Begin, int32 const End) {
+		for (int32 DenseIdx = Begin; DenseIdx < End; DenseIdx++)
+		{
+			FIGVEdge& Edge = (*this)[DenseIdx];
+			FIGVCluster const& SourceParent = *Clusters[Edge.SourceNode->Idx].Parent;
+			FIGVCluster const& TargetParent = *Clusters[Edge.TargetNode->Idx].Parent;
+
+			Edge.LowestCommonAncestor = LCA.Find(SourceParent, TargetParent);
+
+			int32 const LCADepth = LCA.GetDepth(Edge.LowestCommonAncestor->Idx);
+			int32 const NumSourceSide = LCA.GetDepth(SourceParent.Idx) - LCADepth;
+			int32 const NumTargetSide = LCA.GetDepth(TargetParent.Idx) - LCADepth;
+
+			Edge.LowestCommonAncestorIdxInClusters = NumSourceSide;
+			Edge.PathLength = NumSourceSide + 1 + NumTargetSide;
+		}
+	});
+
+	// Lay out the pooled data in dense order
+	int32 const NumPathElements = KWParallelPrefixSum<int32>(
+		NumEdges, [this](int32 const DenseIdx) { return (*this)[DenseIdx].PathLength; },
+		[this](int32 const DenseIdx, int32 const PathOffset) {
+			FIGVEdge& Edge = (*this)[DenseIdx];
+			Edge.PathOffset = PathOffset;
+			Edge.PathCapacity = Edge.PathLength;
+			Edge.NumControlPoints = 0;
+		});
+
+	PathClusters.SetNumUninitialized(NumPathElements);
+	PathLevels.SetNumUninitialized(NumPathElements);
+	PathLevelsDefault.SetNumUninitialized(NumPathElements);
+	PathLevelsBeforeTransition.SetNumUninitialized(NumPathElements);
+	PathLevelsAfterTransition.SetNumUninitialized(NumPathElements);
+	ControlPoints.SetNumUninitialized(NumPathElements);
+	NumUnusedPathElements = 0;
+
+	// Paths and levels, written in place
+	KWParallelFor(NumEdges, [&](int32 const Begin, int32 const End) {
+		for (int32 DenseIdx = Begin; DenseIdx < End; DenseIdx++)
+		{
+			FIGVEdge& Edge = (*this)[DenseIdx];
+			FIGVCluster** const Path = PathClusters.GetData() + Edge.PathOffset;
+			int32 const LCAIdxInClusters = Edge.LowestCommonAncestorIdxInClusters;
+
+			FIGVCluster* Cluster = Clusters[Edge.SourceNode->Idx].Parent;
+			for (int32 Idx = 0; Idx < LCAIdxInClusters; Idx++)
+			{
+				Path[Idx] = Cluster;
+				Cluster = Cluster->Parent;
+			}
+			Path[LCAIdxInClusters] = Edge.LowestCommonAncestor;
+
+			Cluster = Clusters[Edge.TargetNode->Idx].Parent;
+			for (int32 Idx = Edge.PathLength - 1; Idx > LCAIdxInClusters; Idx--)
+			{
+				Path[Idx] = Cluster;
+				Cluster = Cluster->Parent;
+			}
+
+			UpdateDefaultClusterLevels(Edge);
+			CopyDefaultClusterLevels(Edge);
+			SetupSplineControlPoints(Edge);
+		}
+	});
+}
+
+void FIGVEdgeStore::AllocatePath(FIGVEdge& Edge, int32 const Length)
+{
+	if (Length <= Edge.PathCapacity)
+	{
+		Edge.PathLength = Length;
+		return;
+	}
+
+	ReleasePath(Edge);
+	if (NumUnusedPathElements > PathClusters.Num() / 2)
+	{
+		CompactPaths();
+	}
+
+	Edge.PathOffset = PathClusters.Num();
+	Edge.PathLength = Edge.PathCapacity = Length;
+
+	PathClusters.AddUninitialized(Length);
+	PathLevels.AddUninitialized(Length);
+	PathLevelsDefault.AddUninitialized(Length);
+	PathLevelsBeforeTransition.AddUninitialized(Length);
+	PathLevelsAfterTransition.AddUninitialized(Length);
+	ControlPoints.AddUninitialized(Length);
+}
+
+void FIGVEdgeStore::ReleasePath(FIGVEdge& Edge)
+{
+	NumUnusedPathElements += Edge.PathCapacity;
+	Edge.PathOffset = Edge.PathLength = Edge.PathCapacity = 0;
+	Edge.NumControlPoints = 0;
+}
+
+void FIGVEdgeStore::CompactPaths()
+{
+	int32 const NumUsed = PathClusters.Num() - NumUnusedPathElements;
+
+	TArray<FIGVCluster*> NewPathClusters;
+	TArray<float> NewPathLevels, NewPathLevelsDefault, NewPathLevelsBeforeTransition,
+		NewPathLevelsAfterTransition;
+	TArray<FIGVEdgeSplineControlPointRef> NewControlPoints;
+
+	NewPathClusters.Reserve(NumUsed);
+	NewPathLevels.Reserve(NumUsed);
+	NewPathLevelsDefault.Reserve(NumUsed);
+	NewPathLevelsBeforeTransition.Reserve(NumUsed);
+	NewPathLevelsAfterTransition.Reserve(NumUsed);
+	NewControlPoints.Reserve(NumUsed);
+
+	for (FIGVEdge& Edge : *this)
+	{
+		if (Edge.PathCapacity == 0) continue;
+
+		int32 const Offset = Edge.PathOffset;
+		int32 const Length = Edge.PathLength;
+
+		Edge.PathOffset = NewPathClusters.Num();
+		Edge.PathCapacity = Length;
+		NewPathClusters.Append(PathClusters.GetData() + Offset, Length);
+		NewPathLevels.Append(PathLevels.GetData() + Offset, Length);
+		NewPathLevelsDefault.Append(PathLevelsDefault.GetData() + Offset, Length);
+		NewPathLevelsBeforeTransition.Append(PathLevelsBeforeTransition.GetData() + Offset, Length);
+		NewPathLevelsAfterTransition.Append(PathLevelsAfterTransition.GetData() + Offset, Length);
+		NewControlPoints.Append(ControlPoints.GetData() + Offset, Length);
+	}
+
+	PathClusters = MoveTemp(NewPathClusters);
+	PathLevels = MoveTemp(NewPathLevels);
+	PathLevelsDefault = MoveTemp(NewPathLevelsDefault);
+	PathLevelsBeforeTransition = MoveTemp(NewPathLevelsBeforeTransition);
+	PathLevelsAfterTransition = MoveTemp(NewPathLevelsAfterTransition);
+	ControlPoints = MoveTemp(NewControlPoints);
+	NumUnusedPathElements = 0;
+}
+
+void FIGVEdgeStore::SetupClusters(FIGVEdge& Edge)
+{
+	TArray<FIGVCluster>& Clusters = GraphActor->Clusters;
+	FIGVCluster* const SourceParent = Clusters[Edge.SourceNode->Idx].Parent;
+	FIGVCluster* const TargetParent = Clusters[Edge.TargetNode->Idx].Parent;
+
+	// A single edge, so climbing the hierarchy is cheaper than building the LCA of SetupAllClusters
+	Edge.LowestCommonAncestor = FIGVCluster::CommonAncestor(SourceParent, TargetParent);
+
+	int32 NumSourceSide = 0;
+	for (FIGVCluster* Cluster = SourceParent; Cluster != Edge.LowestCommonAncestor;
+		 Cluster = Cluster->Parent)
+	{
+		NumSourceSide++;
+	}
+	int32 NumTargetSide = 0;
+	for (FIGVCluster* Cluster = TargetParent; Cluster != Edge.LowestCommonAncestor;
+		 Cluster = Cluster->Parent)
+	{
+		NumTargetSide++;
+	}
+
+	// The path in the clustering hierarchy, written in place as in SetupAllClusters
+	AllocatePath(Edge, NumSourceSide + 1 + NumTargetSide);
+	Edge.LowestCommonAncestorIdxInClusters = NumSourceSide;
+	FIGVCluster** const Path = PathClusters.GetData() + Edge.PathOffset;
+
+	FIGVCluster* Cluster = SourceParent;
+	for (int32 Idx = 0; Idx < NumSourceSide; Idx++)
+	{
+		Path[Idx] = Cluster;
+		Cluster = Cluster->Parent;
+	}
+	Path[NumSourceSide] = Edge.LowestCommonAncestor;
+
+	Cluster = TargetParent;
+	for (int32 Idx = Edge.PathLength - 1; Idx > NumSourceSide; Idx--)
+	{
+		Path[Idx] = Cluster;
+		Cluster = Cluster->Parent;
+	}
+
+	UpdateDefaultClusterLevels(Edge);
+	CopyDefaultClusterLevels(Edge);
+	SetupSplineControlPoints(Edge);
+}
+
+void FIGVEdgeStore::UpdateDefaultClusterLevels(FIGVEdge& Edge)
+{
+	FIGVCluster* const* const Path = PathClusters.GetData() + Edge.PathOffset;
+	float* const Levels = PathLevelsDefault.GetData() + Edge.PathOffset;
+	for (int32 Idx = 0; Idx < Edge.PathLength; Idx++)
+	{
+		Levels[Idx] = ClusterLevels[Path[Idx]->Idx];
+	}
+}
+
+void FIGVEdgeStore::CopyDefaultClusterLevels(FIGVEdge& Edge)
+{
+	int32 const Offset = Edge.PathOffset;
+	int32 const Size = sizeof(float) * Edge.PathLength;
+	FMemory::Memcpy(PathLevels.GetData() + Offset, PathLevelsDefault.GetData() + Offset, Size);
+	FMemory::Memcpy(PathLevelsBeforeTransition.GetData() + Offset,
+					PathLevelsDefault.GetData() + Offset, Size);
+	FMemory::Memcpy(PathLevelsAfterTransition.GetData() + Offset,
+					PathLevelsDefault.GetData() + Offset, Size);
+}
+
+void FIGVEdgeStore::SetupSplineControlPoints(FIGVEdge& Edge)
+{
+	FIGVCluster* const* const Path = PathClusters.GetData() + Edge.PathOffset;
+	FIGVEdgeSplineControlPointRef* const Out = ControlPoints.GetData() + Edge.PathOffset;
+	int32 NumOut = 0;
+
+	for (int32 Idx = 0, NumPath = Edge.PathLength; Idx < NumPath; Idx++)
+	{
+		FIGVCluster* const Cluster = Path[Idx];
+
+		if (!Cluster->IsRoot())
+		{
+			float const Alpha = float(Idx + 1) / float(NumPath + 1);
+			Out[NumOut++] = FIGVEdgeSplineControlPointRef{Cluster->Idx, Idx, Alpha};
+		}
+	}
+
+	Edge.NumControlPoints = NumOut + 2;
+}
+
+void FIGVEdgeStore::ResolveSplineControlPoints(FIGVEdge const& Edge, bool const bDefaultLevels,
+												 FIGVEdgeSplineControlPointData* const Out) const
+{
+	check(Edge.PathCapacity > 0);
+
+	FIGVEdgeSplineControlPointRef const* const Refs = ControlPoints.GetData() + Edge.PathOffset;
+	int32 const NumRefs = Edge.NumControlPoints - 2;
+
+	float const SourceLevelScale =
+		bDefaultLevels ? GraphActor->DefaultLevelScale : Edge.SourceNode->LevelScale;
+	float const TargetLevelScale =
+		bDefaultLevels ? GraphActor->DefaultLevelScale : Edge.TargetNode->LevelScale;
+
+	Out[0] = FIGVEdgeSplineControlPointData{ClusterPositions[Edge.SourceNode->Idx],
+											SourceLevelScale, 0.0};
+
+	if (bDefaultLevels)
+	{
+		for (int32 Idx = 0; Idx < NumRefs; Idx++)
+		{
+			FIGVEdgeSplineControlPointRef const& Ref = Refs[Idx];
+			Out[Idx + 1] = FIGVEdgeSplineControlPointData{ClusterPositions[Ref.ClusterIdx],
+														  ClusterLevels[Ref.ClusterIdx], Ref.Knot};
+		}
+	}
+	else
+	{
+		float const* const Levels = PathLevels.GetData() + Edge.PathOffset;
+		for (int32 Idx = 0; Idx < NumRefs; Idx++)
+		{
+			FIGVEdgeSplineControlPointRef const& Ref = Refs[Idx];
+			Out[Idx + 1] = FIGVEdgeSplineControlPointData{ClusterPositions[Ref.ClusterIdx],
+														  Levels[Ref.PathIdx], Ref.Knot};
+		}
+	}
+
+	Out[NumRefs + 1] = FIGVEdgeSplineControlPointData{ClusterPositions[Edge.TargetNode->Idx],
+													  TargetLevelScale, 1.0};
+}
+
+void FIGVEdgeStore::UpdateClusterPositions()
+{
+	TArray<FIGVCluster> const& Clusters = GraphActor->Clusters;
+
+	ClusterPositions.SetNumUninitialized(Clusters.Num());
+	for (int32 Idx = 0; Idx < Clusters.Num(); Idx++)
+	{
+		ClusterPositions[Idx] = Clusters[Idx].Pos3D;
+	}
+}
+
+void FIGVEdgeStore::UpdateClusterLevels()
+{
+	TArray<FIGVCluster> const& Clusters = GraphActor->Clusters;
+
+	// Default levels only depend on the height
+	TArray<float, TInlineAllocator<16>> HeightLevels;
+	for (int32 Height = 0; Height <= GraphActor->RootCluster->Height; Height++)
+	{
+		HeightLevels.Add(FIGVCluster::DefaultLevel(GraphActor, Height));
+	}
+
+	ClusterLevels.SetNumUninitialized(Clusters.Num());
+	for (int32 Idx = 0; Idx < Clusters.Num(); Idx++)
+	{
+		ClusterLevels[Idx] = HeightLevels[Clusters[Idx].Height];
+	}
+}
+
+float FIGVEdgeStore::BundlingStrength(FIGVEdge const& Edge) const
+{
+	// TODO: individual BundlingStrength
+	return GraphActor->EdgeBundlingStrength;
+}
+
+bool FIGVEdgeStore::HasHighlightedNode(FIGVEdge const& Edge) const
+{
+	FIGVInteractionState const& Interaction = GraphActor->Interaction;
+	auto const Hand = EControllerHand::Right;
+	return (Interaction.IsHighlighted(Hand, Edge.SourceIdx) ||
+			Interaction.IsHighlighted(Hand, Edge.TargetIdx));
+}
+
+bool FIGVEdgeStore::HasNeighborHighlightedNode(FIGVEdge const& Edge) const
+{
+	FIGVInteractionState const& Interaction = GraphActor->Interaction;
+	return (Interaction.HasHighlightedNeighbor(Edge.SourceIdx) ||
+			Interaction.HasHighlightedNeighbor(Edge.TargetIdx));
+}
+
+bool FIGVEdgeStore::HasBothHighlightedNodes(FIGVEdge const& Edge) const
+{
+	FIGVInteractionState const& Interaction = GraphActor->Interaction;
+	auto const Hand = EControllerHand::Right;
+	return (Interaction.IsHighlighted(Hand, Edge.SourceIdx) &&
+			Interaction.IsHighlighted(Hand, Edge.TargetIdx));
+}
+
+bool FIGVEdgeStore::IsDefaultRenderGroup(FIGVEdge const& Edge) const
+{
+	return !(Edge.bInTransition || HasHighlightedNode(Edge) || HasNeighborHighlightedNode(Edge));
+}
+
+bool FIGVEdgeStore::IsHighlightedRenderGroup(FIGVEdge const& Edge) const
+{
+	return HasBothHighlightedNodes(Edge) ||
+		   (HasHighlightedNode(Edge) && HasNeighborHighlightedNode(Edge));
+}
+
+bool FIGVEdgeStore::IsRemainedRenderGroup(FIGVEdge const& Edge) const
+{
+	return !(IsDefaultRenderGroup(Edge) || IsHighlightedRenderGroup(Edge));
+}
+
+bool FIGVEdgeStore::IsHiddenRenderGroup(FIGVEdge const& Edge) const
+{
+	FIGVInteractionState const& Interaction = GraphActor->Interaction;
+	auto const Hand = EControllerHand::Left;
+	return (Interaction.IsHighlighted(Hand, Edge.SourceIdx) ||
+			Interaction.IsHighlighted(Hand, Edge.TargetIdx));
+}
+
+void FIGVEdgeStore::UpdateRenderGroup(FIGVEdge& Edge)
+{
+	if (IsHiddenRenderGroup(Edge))
+	{
+		Edge.RenderGroup = EIGVEdgeRenderGroup::Hidden;
+	}
+	else if (IsHighlightedRenderGroup(Edge))
+	{
+		Edge.RenderGroup = EIGVEdgeRenderGroup::Highlighted;
+	}
+	else if (IsDefaultRenderGroup(Edge))
+	{
+		Edge.RenderGroup = EIGVEdgeRenderGroup::Default;
+	}
+	else
+	{
+		Edge.RenderGroup = EIGVEdgeRenderGroup::Remained;
+	}
+}
+
+void FIGVEdgeStore::BeginTransition(FIGVEdge& Edge)
+{
+	int32 const Offset = Edge.PathOffset;
+	int32 const Num = Edge.PathLength;
+	int32 const LCAIdxInClusters = Edge.LowestCommonAncestorIdxInClusters;
+
+	FMemory::Memcpy(PathLevelsBeforeTransition.GetData() + Offset, PathLevels.GetData() + Offset,
+					sizeof(float) * Num);
+
+	float const SouceLevelScaleAfterTransition = Edge.SourceNode->LevelScaleAfterTransition;
+	float const TargetLevelScaleAfterTransition = Edge.TargetNode->LevelScaleAfterTransition;
+
+	float* const LevelsAfterTransition = PathLevelsAfterTransition.GetData() + Offset;
+
+	if (HasHighlightedNode(Edge) || HasNeighborHighlightedNode(Edge))
+	{
+		float const HighlightedLevelScaleOfLowestCommonAncestor =
+			HasBothHighlightedNodes(Edge)
+				? GraphActor->HighlightedLevelScale
+				: GraphActor->DefaultLevelScale + GraphActor->ClusterLevelOffset;
+
+		for (int32 Idx = 0; Idx < LCAIdxInClusters; Idx++)
+		{
+			LevelsAfterTransition[Idx] = FMath::Lerp(
+				SouceLevelScaleAfterTransition, HighlightedLevelScaleOfLowestCommonAncestor,
+				float(Idx + 1) / float(LCAIdxInClusters + 1));
+		}
+
+		LevelsAfterTransition[LCAIdxInClusters] = HighlightedLevelScaleOfLowestCommonAncestor;
+
+		for (int32 Idx = LCAIdxInClusters + 1; Idx < Num; Idx++)
+		{
+			LevelsAfterTransition[Idx] = FMath::Lerp(
+				HighlightedLevelScaleOfLowestCommonAncestor, TargetLevelScaleAfterTransition,
+				float(Idx - LCAIdxInClusters) / float(Num - LCAIdxInClusters));
+		}
+	}
+	else
+	{
+		FIGVCluster* const* const Path = PathClusters.GetData() + Offset;
+		for (int32 Idx = 0; Idx < Num; Idx++)
+		{
+			LevelsAfterTransition[Idx] = ClusterLevels[Path[Idx]->Idx];
+		}
+	}
+}
+
+void FIGVEdgeStore::OnHighlightTransitionTimelineUpdate(FIGVEdge& Edge,
+														ETimelineDirection::Type const Direction,
+														float const Alpha)
+{
+	Edge.bInTransition = true;
+	Edge.bUpdateMeshRequired = true;
+	LerpTransitionLevels(Edge, Alpha);
+}
+
+void FIGVEdgeStore::OnHighlightTransitionTimelineFinished(FIGVEdge& Edge,
+														  ETimelineDirection::Type const Direction)
+{
+	Edge.bInTransition = false;
+}
+
+void FIGVEdgeStore::UpdateTransitions(TArray<FIGVEdge*> const& TransitionEdges,
+									  TArray<float> const& Alphas)
+{
+	KWParallelFor(TransitionEdges.Num(), [&](int32 const Begin, int32 const End) {
+		for (int32 Idx = Begin; Idx < End; Idx++)
+		{
+			FIGVEdge& Edge = *TransitionEdges[Idx];
+			Edge.bInTransition = Alphas[Idx] < 1.f;
+			Edge.bUpdateMeshRequired = true;
+			LerpTransitionLevels(Edge, Alphas[Idx]);
+		}
+	}, 64);
+}
+
+void FIGVEdgeStore::LerpTransitionLevels(FIGVEdge const& Edge, float const Alpha)
+{
+	int32 const Offset = Edge.PathOffset;
+	float* const Levels = PathLevels.GetData() + Offset;
+	float const* const LevelsBeforeTransition = PathLevelsBeforeTransition.GetData() + Offset;
+	float const* const LevelsAfterTransition = PathLevelsAfterTransition.GetData() + Offset;
+
+	for (int32 Idx = 0, Num = Edge.PathLength; Idx < Num; Idx++)
+	{
+		Levels[Idx] = FMath::Lerp(LevelsBeforeTransition[Idx], LevelsAfterTransition[Idx], Alpha);
+	}
+}
@@ -0,0 +1,258 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/ChunkedArray.h"
+#include "CoreMinimal.h"
+
+#include "IGVEdge.h"
+
+struct FIGVCluster;
+
+// Generation-checked reference to an edge slot. A handle to a removed edge stays invalid even
+// after its slot is reused by another edge.
+struct IMSVGRAPHVIS_API FIGVEdgeHandle
+{
+	int32 SlotIdx;
+	uint32 Generation;
+
+	FIGVEdgeHandle() : SlotIdx(INDEX_NONE), Generation(0)
+	{
+	}
+
+	FIGVEdgeHandle(int32 const InSlotIdx, uint32 const InGeneration)
+		: SlotIdx(InSlotIdx), Generation(InGeneration)
+	{
+	}
+
+	FORCEINLINE bool IsSet() const
+	{
+		return SlotIdx != INDEX_NONE;
+	}
+
+	FORCEINLINE bool operator==(FIGVEdgeHandle const& Other) const
+	{
+		return SlotIdx == Other.SlotIdx && Generation == Other.Generation;
+	}
+
+	FORCEINLINE bool operator!=(FIGVEdgeHandle const& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend FORCEINLINE uint32 GetTypeHash(FIGVEdgeHandle const& Handle)
+	{
+		return HashCombine(GetTypeHash(Handle.SlotIdx), GetTypeHash(Handle.Generation));
+	}
+};
+
+// Slot map of edges. Edges live in chunked storage so that their addresses never change while
+// other edges are added or removed, which keeps AIGVNodeActor::Edges valid. Live slots are kept
+// in a dense list for iteration, and an index on the unordered (source, target) pair makes edge
+// lookup, insertion and removal O(1).
+//
+// The variable-length data of every edge (cluster path, path levels and spline control points)
+// is pooled in flat arrays shared by all edges, laid out in dense order by SetupAllClusters(), so
+// per-edge loops stream through contiguous memory instead of chasing per-edge allocations.
+class IMSVGRAPHVIS_API FIGVEdgeStore
+{
+public:
+	template <typename StoreType, typename EdgeType>
+	class TIterator
+	{
+	public:
+		TIterator(StoreType& InStore, int32 const InDenseIdx) : Store(InStore), DenseIdx(InDenseIdx)
+		{
+		}
+
+		FORCEINLINE TIterator& operator++()
+		{
+			++DenseIdx;
+			return *this;
+		}
+
+		FORCEINLINE EdgeType& operator*() const
+		{
+			return Store.Slots[Store.DenseSlots[DenseIdx]];
+		}
+
+		FORCEINLINE EdgeType* operator->() const
+		{
+			return &**this;
+		}
+
+		FORCEINLINE bool operator!=(TIterator const& Other) const
+		{
+			return DenseIdx != Other.DenseIdx;
+		}
+
+	private:
+		StoreType& Store;
+		int32 DenseIdx;
+	};
+
+	typedef TIterator<FIGVEdgeStore, FIGVEdge> FIterator;
+	typedef TIterator<FIGVEdgeStore const, FIGVEdge const> FConstIterator;
+
+public:
+	FIGVEdgeStore(class AIGVGraphActor* const InGraphActor);
+
+	void Empty();
+
+	FORCEINLINE int32 Num() const
+	{
+		return DenseSlots.Num();
+	}
+
+	// Adds the edge and indexes it by its SourceIdx and TargetIdx
+	FIGVEdgeHandle Add(FIGVEdge&& Edge);
+
+	// Returns false if the handle is stale
+	bool Remove(FIGVEdgeHandle const Handle);
+
+	bool IsValid(FIGVEdgeHandle const Handle) const;
+
+	FIGVEdge* Get(FIGVEdgeHandle const Handle);
+	FIGVEdge const* Get(FIGVEdgeHandle const Handle) const;
+
+	// Handle of an edge that lives in this store
+	FIGVEdgeHandle GetHandle(FIGVEdge const& Edge) const;
+
+	// Any edge between the two nodes, in either direction
+	FIGVEdgeHandle Find(int32 const NodeIdxA, int32 const NodeIdxB) const;
+
+	// All parallel edges between the two nodes
+	void FindAll(int32 const NodeIdxA, int32 const NodeIdxB,
+				 TArray<FIGVEdgeHandle>& OutHandles) const;
+
+	// Edge at the given position of the dense list; the order changes when edges are removed
+	FORCEINLINE FIGVEdge& operator[](int32 const DenseIdx)
+	{
+		return Slots[DenseSlots[DenseIdx]];
+	}
+
+	FORCEINLINE FIGVEdge const& operator[](int32 const DenseIdx) const
+	{
+		return Slots[DenseSlots[DenseIdx]];
+	}
+
+	FORCEINLINE FIterator begin()
+	{
+		return FIterator(*this, 0);
+	}
+
+	FORCEINLINE FIterator end()
+	{
+		return FIterator(*this, Num());
+	}
+
+	FORCEINLINE FConstIterator begin() const
+	{
+		return FConstIterator(*this, 0);
+	}
+
+	FORCEINLINE FConstIterator end() const
+	{
+		return FConstIterator(*this, Num());
+	}
+
+	// Finds the cluster path of every edge at once and lays out the pooled data in dense order.
+	// Lowest common ancestors come from an Euler tour of the hierarchy (see FIGVClusterLCA) and
+	// both passes over the edges run in parallel.
+	void SetupAllClusters();
+
+	FORCEINLINE TArrayView<FIGVCluster* const> GetClusters(FIGVEdge const& Edge) const
+	{
+		return TArrayView<FIGVCluster* const>(PathClusters.GetData() + Edge.PathOffset,
+											  Edge.PathLength);
+	}
+
+	FORCEINLINE TArrayView<float const> GetClusterLevels(FIGVEdge const& Edge) const
+	{
+		return TArrayView<float const>(PathLevels.GetData() + Edge.PathOffset, Edge.PathLength);
+	}
+
+	// Writes the Edge.NumControlPoints control points of the edge, looked up in the cluster table.
+	// Default levels ignore highlight transitions and node level scales.
+	void ResolveSplineControlPoints(FIGVEdge const& Edge, bool const bDefaultLevels,
+									FIGVEdgeSplineControlPointData* const Out) const;
+
+	// Control points only refer to clusters, so moving clusters or changing the level parameters
+	// updates these tables instead of every edge
+	void UpdateClusterPositions();
+	void UpdateClusterLevels();
+
+	// Per-edge behavior, operating on the pooled data
+	void SetupClusters(FIGVEdge& Edge);  // For edges added or moved after SetupAllClusters
+
+	void UpdateDefaultClusterLevels(FIGVEdge& Edge);
+	void CopyDefaultClusterLevels(FIGVEdge& Edge);  // Into the current and transition levels
+
+	float BundlingStrength(FIGVEdge const& Edge) const;
+
+	bool HasHighlightedNode(FIGVEdge const& Edge) const;
+	bool HasNeighborHighlightedNode(FIGVEdge const& Edge) const;
+	bool HasBothHighlightedNodes(FIGVEdge const& Edge) const;
+
+	bool IsDefaultRenderGroup(FIGVEdge const& Edge) const;
+	bool IsHighlightedRenderGroup(FIGVEdge const& Edge) const;
+	bool IsRemainedRenderGroup(FIGVEdge const& Edge) const;
+	bool IsHiddenRenderGroup(FIGVEdge const& Edge) const;  //DPK
+	void UpdateRenderGroup(FIGVEdge& Edge);
+
+	void BeginTransition(FIGVEdge& Edge);
+	void OnHighlightTransitionTimelineUpdate(FIGVEdge& Edge,
+											 ETimelineDirection::Type const Direction,
+											 float const Alpha);
+	void OnHighlightTransitionTimelineFinished(FIGVEdge& Edge,
+											   ETimelineDirection::Type const Direction);
+
+	// Blends the levels of every edge by its alpha, for FIGVHighlightTransitionAnimator. Edges stay
+	// in transition until their alpha reaches 1.
+	void UpdateTransitions(TArray<FIGVEdge*> const& TransitionEdges,
+						   TArray<float> const& Alphas);
+
+	static FORCEINLINE uint64 PairKey(int32 const NodeIdxA, int32 const NodeIdxB)
+	{
+		uint32 const Lo = uint32(FMath::Min(NodeIdxA, NodeIdxB));
+		uint32 const Hi = uint32(FMath::Max(NodeIdxA, NodeIdxB));
+		return (uint64(Hi) << 32) | uint64(Lo);
+	}
+
+protected:
+	// Gives the edge room for a path of the given length. Blocks are reused in place when they are
+	// large enough; otherwise a new block is appended and the pools are compacted once more than
+	// half of them is unused.
+	void AllocatePath(FIGVEdge& Edge, int32 const Length);
+	void ReleasePath(FIGVEdge& Edge);
+	void CompactPaths();
+
+	void SetupSplineControlPoints(FIGVEdge& Edge);
+	void LerpTransitionLevels(FIGVEdge const& Edge, float const Alpha);
+
+private:
+	class AIGVGraphActor* const GraphActor;
+
+	TChunkedArray<FIGVEdge> Slots;
+	TArray<uint32> Generations;
+	TArray<int32> SlotDenseIdxs;  // INDEX_NONE for free slots
+	TArray<int32> FreeSlots;
+
+	TArray<int32> DenseSlots;
+
+	TMultiMap<uint64, int32> PairIndex;
+
+	// Pooled per-edge data, see FIGVEdge::PathOffset
+	TArray<struct FIGVCluster*> PathClusters;
+	TArray<float> PathLevels;
+	TArray<float> PathLevelsDefault;
+	TArray<float> PathLevelsBeforeTransition;
+	TArray<float> PathLevelsAfterTransition;
+	TArray<FIGVEdgeSplineControlPointRef> ControlPoints;
+	int32 NumUnusedPathElements;
+
+	// Cluster table, indexed like AIGVGraphActor::Clusters
+	TArray<FVector> ClusterPositions;
+	TArray<float> ClusterLevels;  // Default levels
+};
@@ -0,0 +1,120 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVFrameGovernor.h"
+
+#include "RenderCore.h"
+
+#include "IGVEdgeMeshComponent.h"
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Governor Game Thread (ms)"), STAT_IGVGovernorGameThreadTime,
+						   STATGROUP_IGV);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Governor Render Thread (ms)"), STAT_IGVGovernorRenderThreadTime,
+						   STATGROUP_IGV);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Governor GPU (ms)"), STAT_IGVGovernorGPUTime, STATGROUP_IGV);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Governor Frame Budget (ms)"), STAT_IGVGovernorFrameBudget,
+						   STATGROUP_IGV);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Governor Quality Level"), STAT_IGVGovernorQualityLevel,
+						   STATGROUP_IGV);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Edge Vertices"), STAT_IGVEdgeVertices, STATGROUP_IGV);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Edge Sample Tolerance"), STAT_IGVEdgeSampleTolerance,
+						   STATGROUP_IGV);
+
+static float const FrameTimeSmoothing = 0.1f;  // Weight of the newest frame
+
+// Fractions of the frame budget
+static float const OverBudgetThreshold = 0.95f;
+static float const UnderBudgetThreshold = 0.7f;
+
+// Seconds; stepping down is quicker than stepping up, since dropped frames are worse in a headset
+static float const DownscaleDelay = 0.5f;
+static float const UpscaleDelay = 3.f;
+static float const Cooldown = 1.f;
+
+FIGVFrameGovernor::FIGVFrameGovernor(AIGVGraphActor* const InGraphActor)
+	: GraphActor(InGraphActor),
+	  GameThreadTime(0.f),
+	  RenderThreadTime(0.f),
+	  GPUTime(0.f),
+	  QualityLevel(0),
+	  OverBudgetTime(0.f),
+	  UnderBudgetTime(0.f),
+	  CooldownTime(0.f)
+{
+}
+
+void FIGVFrameGovernor::Update(float const DeltaTime)
+{
+	// Cycles of the previous frame; the GPU time is 0 where it is not measured
+	GameThreadTime = FMath::Lerp(GameThreadTime, FPlatformTime::ToMilliseconds(GGameThreadTime),
+								 FrameTimeSmoothing);
+	RenderThreadTime = FMath::Lerp(
+		RenderThreadTime, FPlatformTime::ToMilliseconds(GRenderThreadTime), FrameTimeSmoothing);
+	GPUTime =
+		FMath::Lerp(GPUTime, FPlatformTime::ToMilliseconds(GGPUFrameTime), FrameTimeSmoothing);
+
+	float const FrameBudget = 1000.f / FMath::Max(GraphActor->GovernorTargetFrameRate, 1.f);
+	float const FrameTime = GetFrameTime();
+
+	SET_FLOAT_STAT(STAT_IGVGovernorGameThreadTime, GameThreadTime);
+	SET_FLOAT_STAT(STAT_IGVGovernorRenderThreadTime, RenderThreadTime);
+	SET_FLOAT_STAT(STAT_IGVGovernorGPUTime, GPUTime);
+	SET_FLOAT_STAT(STAT_IGVGovernorFrameBudget, FrameBudget);
+	SET_DWORD_STAT(STAT_IGVGovernorQualityLevel, QualityLevel);
+	if (UIGVEdgeMeshComponent const* const EdgeMesh = GraphActor->DefaultEdgeGroupMeshComponent)
+	{
+		SET_DWORD_STAT(STAT_IGVEdgeVertices, EdgeMesh->NumSampledVertices);
+		SET_FLOAT_STAT(STAT_IGVEdgeSampleTolerance, EdgeMesh->SampleTolerance);
+	}
+
+	if (!GraphActor->bFrameGovernor)
+	{
+		if (QualityLevel != 0) SetQualityLevel(0);
+		return;
+	}
+
+	if (CooldownTime > 0.f)
+	{
+		CooldownTime -= DeltaTime;
+		return;
+	}
+
+	if (FrameTime > FrameBudget * OverBudgetThreshold)
+	{
+		OverBudgetTime += DeltaTime;
+		UnderBudgetTime = 0.f;
+	}
+	else if (FrameTime < FrameBudget * UnderBudgetThreshold)
+	{
+		UnderBudgetTime += DeltaTime;
+		OverBudgetTime = 0.f;
+	}
+	else
+	{
+		OverBudgetTime = 0.f;
+		UnderBudgetTime = 0.f;
+	}
+
+	if (OverBudgetTime > DownscaleDelay && QualityLevel < NumQualityLevels - 1)
+	{
+		SetQualityLevel(QualityLevel + 1);
+	}
+	else if (UnderBudgetTime > UpscaleDelay && QualityLevel > 0)
+	{
+		SetQualityLevel(QualityLevel - 1);
+	}
+}
+
+void FIGVFrameGovernor::SetQualityLevel(int32 const NewQualityLevel)
+{
+	IGV_LOG(Log, TEXT("Quality level %d -> %d (game %.2f ms, render %.2f ms, GPU %.2f ms)"),
+			QualityLevel, NewQualityLevel, GameThreadTime, RenderThreadTime, GPUTime);
+
+	QualityLevel = NewQualityLevel;
+	OverBudgetTime = 0.f;
+	UnderBudgetTime = 0.f;
+	CooldownTime = Cooldown;
+
+	GraphActor->UpdateEdgeSampling();
+}
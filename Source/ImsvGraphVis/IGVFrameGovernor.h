@@ -0,0 +1,62 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Holds the target frame rate by trading edge detail for time. The slowest of the game thread,
+// render thread and GPU is smoothed over frames and compared with the frame budget. After being
+// over budget for a short while, or well under it for a longer while, the quality level steps
+// down or up by one, and then holds for a cooldown while the edge meshes are resampled.
+//
+// Every level coarsens the edges without rebuilding their buffers: the curvature sampling
+// tolerance doubles, the edge vertex budget halves and the view LOD angles shrink by a quarter.
+class IMSVGRAPHVIS_API FIGVFrameGovernor
+{
+	class AIGVGraphActor* const GraphActor;
+
+	// Smoothed frame times, in milliseconds
+	float GameThreadTime;
+	float RenderThreadTime;
+	float GPUTime;
+
+	int32 QualityLevel;  // 0 for full detail
+	float OverBudgetTime;
+	float UnderBudgetTime;
+	float CooldownTime;
+
+public:
+	static int32 const NumQualityLevels = 4;
+
+	FIGVFrameGovernor(class AIGVGraphActor* const InGraphActor);
+
+	void Update(float const DeltaTime);
+
+	FORCEINLINE int32 GetQualityLevel() const
+	{
+		return QualityLevel;
+	}
+
+	FORCEINLINE float GetFrameTime() const
+	{
+		return FMath::Max3(GameThreadTime, RenderThreadTime, GPUTime);
+	}
+
+	FORCEINLINE float GetSampleToleranceScale() const
+	{
+		return float(1 << QualityLevel);
+	}
+
+	FORCEINLINE float GetVertexBudgetScale() const
+	{
+		return 1.f / float(1 << QualityLevel);
+	}
+
+	FORCEINLINE float GetLODAngleScale() const
+	{
+		return 1.f - 0.25f * QualityLevel;
+	}
+
+protected:
+	void SetQualityLevel(int32 const NewQualityLevel);
+};
@@ -4,6 +4,7 @@
 
 #include "IGVGraphActor.h"
 
+#include "Camera/CameraComponent.h"
 #include "Components/PostProcessComponent.h"
 #include "Components/SkyLightComponent.h"
 #include "Components/SphereComponent.h"
@@ -30,9 +31,15 @@ UMaterialInterface* GetOutlineMaterial()
 AIGVGraphActor::AIGVGraphActor()
 	: Filename("lesmis.igv.json"),
 	  Nodes(),
-	  Edges(),
+	  Edges(this),
 	  Clusters(),
 	  PlanarExtent(1.f, 1.f),
+	  NormalizationOffset(FVector2D::ZeroVector),
+	  NormalizationExtent(1.f, 1.f),
+	  PlanarExtentBeforeTransition(1.f, 1.f),
+	  PlanarExtentAfterTransition(1.f, 1.f),
+	  ViewTransitionTime(0.f),
+	  bInViewTransition(false),
 	  FieldOfView(90.f),
 	  AspectRatio(16.f / 9.f),
 	  AspectRatioEnum(AREnum::HD),
@@ -41,27 +48,45 @@ AIGVGraphActor::AIGVGraphActor()
 	  ClusterLevelExponent(2.f),
 	  ClusterLevelOffset(.1f),
 	  TreemapNesting(.1f),
+	  bParallelTreemapLayout(true),
+	  TreemapRandomSeed(0),
 	  EdgeSplineResolution(24),
 	  EdgeWidth(8.f),
 	  EdgeNumSides(4),
+	  bEdgeIndexTemplate(true),
+	  bCullEdgeChunks(false),
+	  EdgeChunkBoundsMargin(.02f),
+	  bEdgeLOD(true),
+	  EdgeLODFoveaAngle(30.f),
+	  EdgeLODPeripheryAngle(70.f),
+	  EdgeLODMinAngularSize(2.f),
+	  bAdaptiveEdgeSampling(true),
+	  EdgeSampleTolerance(0.1f),
+	  EdgeVertexBudget(4000000),
+	  bFrameGovernor(true),
+	  GovernorTargetFrameRate(90.f),
+	  bBatchedHighlightTransitions(true),
+	  HighlightTransitionDuration(.5f),
+	  ViewTransitionDuration(.3f),
 	  EdgeBundlingStrength(.9f),
 	  ColorHueMin(0.f),
 	  ColorHueMax(210.f),
 	  ColorHueOffset(0.f),
 	  ColorChroma(.5f),
 	  ColorLuminance(.5f),
-	  PickRayDistSortedNodes(),
-	  LastNearestNode(nullptr),
-	  LastPickedNode(nullptr),
+	  PickRayQuery(),
+	  PickRays(),
+	  PickRayHits(),
+	  Interaction(),
+	  Statistics(this),
+	  FrameGovernor(this),
+	  HighlightTransitionAnimator(this),
 	  PickDistanceThreshold(30),
 	  SelectAllDistanceThreshold(100),
 	  DefaultLevelScale(1.f),
 	  HighlightedLevelScale(.5f),
 	  NeighborHighlightedLevelScale(.75f),
-	  bUpdateDefaultEdgeMeshRequired(true),
-	  LeftPickRayDistSortedNodes(),
-	  RightPickRayDistSortedNodes()
-      //PickRayDistSortedNodesHandMap()
+	  bUpdateDefaultEdgeMeshRequired(true)
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -105,19 +130,6 @@ AIGVGraphActor::AIGVGraphActor()
   // Initialize Http Module
 	Http = &FHttpModule::Get();
 
-  // Initialize Last Picked Node Mapping to Left and Right controllers.
-	LastPickedNodeMap.Add(EControllerHand::Left, nullptr);
-	LastPickedNodeMap.Add(EControllerHand::Right, nullptr);
-
-  // Initialize Last Nearest Node Mapping to Left and Right controllers.
-	LastNearestNodeMap.Add(EControllerHand::Left, nullptr);
-	LastNearestNodeMap.Add(EControllerHand::Right, nullptr);
-
-  // Initialize Pick Ray Distance Sorted Node Mapping to Left and Right controllers.
-	PickRayDistSortedNodesHandMap.Add(EControllerHand::Left, FPickRaySortedNodesArray());
-	PickRayDistSortedNodesHandMap.Add(EControllerHand::Right, FPickRaySortedNodesArray());
-
-	//IGV_LOG(Log, TEXT("PickRay Sorted Key Count: %d"), PickRayDistSortedNodesHandMap.Num());
 	//TCircularQueue<class AIGVNodeActor*> NodeBridgeQueue = TCircularQueue<class AIGVNodeActor*>(3);
 }
 
@@ -162,13 +174,38 @@ void AIGVGraphActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// Picks up the edge meshes updated since the last tick
+	WaitForEdgeMeshUpdate();
+
+	FrameGovernor.Update(DeltaTime);
 	UpdateInteraction();
-	UpdateEdgeMeshes();
+	HighlightTransitionAnimator.Update(DeltaTime);
+	UpdateViewTransition(DeltaTime);
+	UpdateEdgeLOD();
+	BeginEdgeMeshUpdate();
+}
+
+void AIGVGraphActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	WaitForEdgeMeshUpdateTask();
+	EdgeMeshUpdateDeferredEdits.Empty();  // The nodes may be gone
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Remove all Nodes, Edges, and Clusters. In addition, clear all mappings
 void AIGVGraphActor::EmptyGraph()
 {
+	WaitForEdgeMeshUpdate();
+	HighlightTransitionAnimator.Reset();
+
+	// The transition would otherwise rescale the clusters freed below on the next tick
+	if (bInViewTransition)
+	{
+		PlanarExtent = PlanarExtentAfterTransition;
+		bInViewTransition = false;
+	}
+
 	for (AIGVNodeActor* Node : Nodes)
 	{
 		Node->Destroy();
@@ -176,15 +213,13 @@ void AIGVGraphActor::EmptyGraph()
 	Nodes.Empty();
 	Edges.Empty();
 	Clusters.Empty();
+	RootCluster = nullptr;
 
-	PickRayDistSortedNodes.Empty();
-	LeftPickRayDistSortedNodes.Empty();
-	RightPickRayDistSortedNodes.Empty();
-
-	PickRayDistSortedNodesHandMap.Empty(); //DPK Added
+	PickRayQuery.Empty();
+	PickRayHits.Empty();
 
-	LastNearestNode = nullptr;
-	LastPickedNode = nullptr;
+	Interaction.Reset(0);
+	Statistics.Reset(0);
 }
 
 // Reset Graph by removing old elements and re-querying the Neo4j database
@@ -199,18 +234,12 @@ void AIGVGraphActor::ResetGraph()
 // nodes and edges.
 void AIGVGraphActor::RedrawGraph()
 {
+	WaitForEdgeMeshUpdate();
+
 	Clusters.Empty();
 
-	LastNearestNode = nullptr;
-	LastPickedNode = nullptr;
+	Interaction.ResetPickedNodes();
 
-	for (FIGVEdge& Edge : Edges) {
-		Edge.Clusters.Empty();
-		Edge.ClusterLevels.Empty();
-		Edge.ClusterLevelsDefault.Empty();
-		Edge.ClusterLevelsBeforeTransition.Empty();
-		Edge.ClusterLevelsAfterTransition.Empty();
-	}
 	ConstructClusters();
 	SetupClusters();
 	UpdateColors();
@@ -218,8 +247,187 @@ void AIGVGraphActor::RedrawGraph()
 	SetupEdgeMeshes();
 }
 
+void AIGVGraphActor::RedrawGraphAfterEdgeEdit(int32 const NodeIdxA, int32 const NodeIdxB)
+{
+	WaitForEdgeMeshUpdate();
+
+	auto const HasLeafCluster = [this](int32 const NodeIdx) {
+		return Clusters.IsValidIndex(NodeIdx) && Clusters[NodeIdx].NodeIdx == NodeIdx &&
+			   Clusters[NodeIdx].Parent != nullptr;
+	};
+
+	if (RootCluster == nullptr || !HasLeafCluster(NodeIdxA) || !HasLeafCluster(NodeIdxB))
+	{
+		IGV_LOG(Log, TEXT("Edge edit outside of the clustering hierarchy, redrawing graph"));
+		RedrawGraph();
+		return;
+	}
+
+	// Localized recluster: move the endpoints to better sibling clusters, if any
+	FIGVCluster* SubtreeRoot = nullptr;
+	TArray<AIGVNodeActor*, TInlineAllocator<2>> MovedNodes;
+
+	for (int32 const NodeIdx : {NodeIdxA, NodeIdxB})
+	{
+		FIGVCluster& Leaf = Clusters[NodeIdx];
+		FIGVCluster* const OldParent = Leaf.Parent;
+		FIGVCluster* const NewParent = FindBestClusterForNode(NodeIdx);
+		if (NewParent == nullptr || NewParent == OldParent) continue;
+
+		IGV_LOG(Log, TEXT("Moving node %d from cluster %d to cluster %d"), NodeIdx, OldParent->Idx,
+				NewParent->Idx);
+
+		MoveLeafCluster(Leaf, *NewParent);
+		MovedNodes.Add(Leaf.Node);
+
+		FIGVCluster* const MoveRoot = FIGVCluster::CommonAncestor(OldParent, NewParent);
+		SubtreeRoot =
+			SubtreeRoot ? FIGVCluster::CommonAncestor(SubtreeRoot, MoveRoot) : MoveRoot;
+
+		// Take the color of the new community
+		for (FIGVCluster* const Sibling : NewParent->Children)
+		{
+			if (Sibling != &Leaf)
+			{
+				Leaf.Node->UpdateColor(Sibling->Node->BaseColor);
+				break;
+			}
+		}
+	}
+
+	// Edges whose path in the hierarchy changed, or that were just added
+	TArray<FIGVEdge*> ChangedEdges;
+	TSet<FIGVEdge*> ChangedEdgeSet;
+	auto const AddChangedEdges = [&](AIGVNodeActor* const Node) {
+		for (FIGVEdge* const Edge : Node->Edges)
+		{
+			bool bIsAlreadyInSet = false;
+			ChangedEdgeSet.Add(Edge, &bIsAlreadyInSet);
+			if (!bIsAlreadyInSet)
+			{
+				ChangedEdges.Add(Edge);
+			}
+		}
+	};
+
+	for (AIGVNodeActor* const Node : MovedNodes)
+	{
+		AddChangedEdges(Node);
+	}
+	for (FIGVEdge* const Edge : Nodes[NodeIdxA]->Edges)
+	{
+		if (Edge->LowestCommonAncestor == nullptr && !ChangedEdgeSet.Contains(Edge))
+		{
+			ChangedEdgeSet.Add(Edge);
+			ChangedEdges.Add(Edge);
+		}
+	}
+
+	for (FIGVEdge* const Edge : ChangedEdges)
+	{
+		Edges.SetupClusters(*Edge);
+	}
+
+	// Relayout, then remesh every edge with an endpoint inside the relaid subtree
+	if (SubtreeRoot != nullptr)
+	{
+		UpdateSubtreeTreemapLayout(*SubtreeRoot);
+
+		SubtreeRoot->ForEachDescendantFirst([&](FIGVCluster& Cluster) {
+			if (Cluster.IsLeaf())
+			{
+				AddChangedEdges(Cluster.Node);
+			}
+		});
+	}
+
+	SetupEdgeMeshes(ChangedEdges);
+}
+
+FIGVCluster* AIGVGraphActor::FindBestClusterForNode(int32 const NodeIdx)
+{
+	FIGVCluster& Leaf = Clusters[NodeIdx];
+	FIGVCluster* const OldParent = Leaf.Parent;
+	AIGVNodeActor* const Node = Leaf.Node;
+
+	// Leaving would empty the cluster
+	if (OldParent->Children.Num() < 2) return nullptr;
+
+	double const TotalWeight = 2.0 * Edges.Num();
+	if (TotalWeight == 0) return nullptr;
+
+	auto const Degree = [](FIGVCluster const* const Cluster) {
+		return Cluster->Node->Edges.Num();
+	};
+
+	// Number of edges from the node into each neighboring cluster, as in one Louvain move
+	TMap<FIGVCluster*, int32> NeighborLinks;
+	NeighborLinks.Add(OldParent, 0);
+	for (AIGVNodeActor* const Neighbor : Node->Neighbors)
+	{
+		if (Neighbor == Node || !Clusters.IsValidIndex(Neighbor->Idx)) continue;
+		FIGVCluster* const NeighborParent = Clusters[Neighbor->Idx].Parent;
+		if (NeighborParent != nullptr && NeighborParent->Height == OldParent->Height)
+		{
+			NeighborLinks.FindOrAdd(NeighborParent)++;
+		}
+	}
+
+	int32 const NodeDegree = Degree(&Leaf);
+
+	FIGVCluster* BestCluster = OldParent;
+	double BestGain = -DBL_MAX;
+	for (TPair<FIGVCluster*, int32> const& Pair : NeighborLinks)
+	{
+		FIGVCluster* const Cluster = Pair.Key;
+
+		int32 TotalDegree = 0;
+		for (FIGVCluster* const Child : Cluster->Children)
+		{
+			TotalDegree += Degree(Child);
+		}
+		if (Cluster == OldParent)
+		{
+			TotalDegree -= NodeDegree;
+		}
+
+		double const Gain = Pair.Value - double(TotalDegree) * NodeDegree / TotalWeight;
+		if (Gain > BestGain || (Gain == BestGain && Cluster == OldParent))
+		{
+			BestGain = Gain;
+			BestCluster = Cluster;
+		}
+	}
+
+	return BestCluster;
+}
+
+void AIGVGraphActor::MoveLeafCluster(FIGVCluster& Leaf, FIGVCluster& NewParent)
+{
+	FIGVCluster* const OldParent = Leaf.Parent;
+
+	Statistics.OnNodeMoved(Leaf.NodeIdx, OldParent->Idx, NewParent.Idx);
+
+	OldParent->Children.RemoveSingle(&Leaf);
+	for (FIGVCluster* Cluster = OldParent; Cluster != nullptr; Cluster = Cluster->Parent)
+	{
+		Cluster->NumDescendantNodes--;
+	}
+
+	NewParent.Children.Add(&Leaf);
+	for (FIGVCluster* Cluster = &NewParent; Cluster != nullptr; Cluster = Cluster->Parent)
+	{
+		Cluster->NumDescendantNodes++;
+	}
+
+	Leaf.Parent = &NewParent;
+	Leaf.ParentIdx = NewParent.Idx;
+}
+
 void AIGVGraphActor::SetupGraph()
 {
+	WaitForEdgeMeshUpdate();
+
 	SetupNodes();
 	SetupEdges();
 	ConstructClusters(); // Construct clusters natively using the Louvain algo
@@ -236,20 +444,13 @@ void AIGVGraphActor::SetupNodes()
 {
 	IGV_LOG(Log, TEXT("Setting up nodes"));
 
-	PickRayDistSortedNodesHandMap.Empty();
-
-	PickRayDistSortedNodesHandMap.Add(EControllerHand::Left, FPickRaySortedNodesArray());
-	PickRayDistSortedNodesHandMap.Add(EControllerHand::Right, FPickRaySortedNodesArray());
+	Interaction.Reset(Nodes.Num());
+	Statistics.Reset(Nodes.Num());
 
 	for (AIGVNodeActor* const Node : Nodes)
 	{
 		Node->SetText(Node->Label);
 		Node->SetImage(Node->Label); // Setting Images
-		PickRayDistSortedNodes.Add(Node);
-		LeftPickRayDistSortedNodes.Add(Node);
-		RightPickRayDistSortedNodes.Add(Node);
-		PickRayDistSortedNodesHandMap[EControllerHand::Left].Nodes.Add(Node);
-		PickRayDistSortedNodesHandMap[EControllerHand::Right].Nodes.Add(Node);
 
 		IGV_LOG(Log, TEXT("Node: %s"), *Node->ToString());
 	}
@@ -273,6 +474,52 @@ void AIGVGraphActor::SetupEdges()
 	}
 }
 
+FIGVEdgeHandle AIGVGraphActor::AddEdge(int32 const SourceIdx, int32 const TargetIdx)
+{
+	FIGVEdge NewEdge;
+	NewEdge.SourceIdx = SourceIdx;
+	NewEdge.TargetIdx = TargetIdx;
+
+	FIGVEdgeHandle const Handle = Edges.Add(MoveTemp(NewEdge));
+	FIGVEdge& Edge = *Edges.Get(Handle);
+
+	Edge.SourceNode = Nodes[Edge.SourceIdx];
+	Edge.TargetNode = Nodes[Edge.TargetIdx];
+
+	Edge.SourceNode->Edges.Add(&Edge);
+	Edge.TargetNode->Edges.Add(&Edge);
+
+	Edge.SourceNode->Neighbors.Add(Edge.TargetNode);
+	Edge.TargetNode->Neighbors.Add(Edge.SourceNode);
+
+	IGV_LOG(Log, TEXT("Created Edge: %s"), *Edge.ToString());
+
+	Statistics.OnEdgeAdded(SourceIdx, TargetIdx);
+
+	return Handle;
+}
+
+void AIGVGraphActor::RemoveEdge(FIGVEdgeHandle const Handle)
+{
+	FIGVEdge* const Edge = Edges.Get(Handle);
+	if (Edge == nullptr) return;
+
+	IGV_LOG(Log, TEXT("Removing Edge: %s"), *Edge->ToString());
+
+	// Parallel edges add the same neighbor more than once
+	Edge->SourceNode->Neighbors.RemoveSingle(Edge->TargetNode);
+	Edge->TargetNode->Neighbors.RemoveSingle(Edge->SourceNode);
+
+	Edge->SourceNode->Edges.RemoveSingle(Edge);
+	Edge->TargetNode->Edges.RemoveSingle(Edge);
+
+	int32 const SourceIdx = Edge->SourceIdx;
+	int32 const TargetIdx = Edge->TargetIdx;
+	Edges.Remove(Handle);
+
+	Statistics.OnEdgeRemoved(SourceIdx, TargetIdx);
+}
+
 
 void AIGVGraphActor::SetupClusters()
 {
@@ -300,11 +547,9 @@ void AIGVGraphActor::SetupClusters()
 		IGV_LOG(Log, TEXT("Cluster: %s"), *Cluster.ToString());
 	}
 
-	for (FIGVEdge& Edge : Edges)
-	{
-		IGV_LOG(Log, TEXT("Clusters for Edge: %s"), *Edge.ToString());
-		Edge.SetupClusters();
-	}
+	Edges.SetupAllClusters();
+
+	Statistics.Rebuild();
 }
 
 // Utilize Louvain algorithm to generate clusterings for given nodes and edges.
@@ -434,6 +679,8 @@ float AIGVGraphActor::GetSphereRadius() const
 
 void AIGVGraphActor::SetSphereRadius(float Radius)
 {
+	WaitForEdgeMeshUpdate();
+
 	SphereComponent->InitSphereRadius(Radius);
 }
 
@@ -460,6 +707,29 @@ FVector AIGVGraphActor::Project(FVector2D const& P) const
 	return FVector::ZeroVector;
 }
 
+void AIGVGraphActor::ProjectNodes(TArray<AIGVNodeActor*> const& ProjectedNodes)
+{
+	int32 const NumNodes = ProjectedNodes.Num();
+
+	TArray<float> X, Y;
+	X.SetNumUninitialized(NumNodes);
+	Y.SetNumUninitialized(NumNodes);
+	for (int32 Idx = 0; Idx < NumNodes; Idx++)
+	{
+		X[Idx] = ProjectedNodes[Idx]->Pos2D.X;
+		Y[Idx] = ProjectedNodes[Idx]->Pos2D.Y;
+	}
+
+	TArray<FVector> Positions;
+	Positions.SetNumUninitialized(NumNodes);
+	ProjectToSphere(ProjectionMode, X, Y, Positions);
+
+	for (int32 Idx = 0; Idx < NumNodes; Idx++)
+	{
+		ProjectedNodes[Idx]->SetPos3D(Positions[Idx]);
+	}
+}
+
 void AIGVGraphActor::UpdatePlanarExtent()
 {
 	PlanarExtent.X = FMath::DegreesToRadians(FieldOfView * 0.5);
@@ -468,7 +738,10 @@ void AIGVGraphActor::UpdatePlanarExtent()
 
 void AIGVGraphActor::NormalizeNodePosition()
 {
+	WaitForEdgeMeshUpdate();
+
 	UpdatePlanarExtent();
+	bInViewTransition = false;  // The new layout is already at the current extent
 
 	FBox2D Bounds(ForceInitToZero);
 	for (AIGVNodeActor* const Node : Nodes)
@@ -479,22 +752,72 @@ void AIGVGraphActor::NormalizeNodePosition()
 	FVector2D const BoundCenter = Bounds.GetCenter();
 	FVector2D const BoundExtent = Bounds.GetExtent();
 
+	NormalizationOffset = BoundCenter;
+	NormalizationExtent = BoundExtent;
+
 	for (AIGVNodeActor* const Node : Nodes)
 	{
-		FVector2D& P = Node->Pos2D;
-		P -= BoundCenter;
-		P /= BoundExtent;
-		P *= PlanarExtent;
-		Node->SetPos3D();
+		Node->NormalizedPos2D = (Node->Pos2D - BoundCenter) / BoundExtent;
 	}
+	SetPlanarExtent(PlanarExtent);
+}
+
+void AIGVGraphActor::SetPlanarExtent(FVector2D const& NewPlanarExtent)
+{
+	PlanarExtent = NewPlanarExtent;
+
+	if (RootCluster == nullptr || Nodes.Num() == 0) return;
+
+	for (AIGVNodeActor* const Node : Nodes)
+	{
+		Node->Pos2D = Node->NormalizedPos2D * PlanarExtent;
+	}
+	ProjectNodes(Nodes);
 
 	RootCluster->SetPosNonLeaf();
+	Edges.UpdateClusterPositions();
 
 	bUpdateDefaultEdgeMeshRequired = true;
 }
 
+void AIGVGraphActor::UpdateViewExtent()
+{
+	WaitForEdgeMeshUpdate();
+
+	FVector2D const OldPlanarExtent = PlanarExtent;
+	UpdatePlanarExtent();
+
+	// Nothing laid out to rescale yet
+	if (RootCluster == nullptr || Nodes.Num() == 0) return;
+
+	PlanarExtentBeforeTransition = OldPlanarExtent;
+	PlanarExtentAfterTransition = PlanarExtent;
+	PlanarExtent = OldPlanarExtent;
+	ViewTransitionTime = 0.f;
+	bInViewTransition = true;
+
+	if (ViewTransitionDuration <= 0.f) UpdateViewTransition(0.f);
+}
+
+void AIGVGraphActor::UpdateViewTransition(float const DeltaTime)
+{
+	if (!bInViewTransition) return;
+
+	ViewTransitionTime += DeltaTime;
+	float const Progress =
+		ViewTransitionDuration > 0.f ? FMath::Min(ViewTransitionTime / ViewTransitionDuration, 1.f)
+									 : 1.f;
+	float const Alpha = FMath::InterpEaseInOut(0.f, 1.f, Progress, 2.f);
+
+	SetPlanarExtent(
+		FMath::Lerp(PlanarExtentBeforeTransition, PlanarExtentAfterTransition, Alpha));
+	bInViewTransition = Progress < 1.f;
+}
+
 void AIGVGraphActor::UpdateTreemapLayout()
 {
+	WaitForEdgeMeshUpdate();
+
 	UpdatePlanarExtent();
 
 	FIGVTreemapLayout Layout(this);
@@ -503,17 +826,40 @@ void AIGVGraphActor::UpdateTreemapLayout()
 	NormalizeNodePosition();
 }
 
+void AIGVGraphActor::UpdateSubtreeTreemapLayout(FIGVCluster& SubtreeRoot)
+{
+	FIGVTreemapLayout Layout(this);
+	Layout.ComputeSubtree(SubtreeRoot);
+
+	// Reuse the normalization of the full layout so that the rest of the graph stays in place
+	TArray<AIGVNodeActor*> SubtreeNodes;
+	SubtreeRoot.ForEachDescendantFirst([this, &SubtreeNodes](FIGVCluster& Cluster) {
+		if (Cluster.IsLeaf())
+		{
+			AIGVNodeActor* const Node = Cluster.Node;
+			Node->NormalizedPos2D = (Node->Pos2D - NormalizationOffset) / NormalizationExtent;
+			Node->Pos2D = Node->NormalizedPos2D * PlanarExtent;
+			SubtreeNodes.Add(Node);
+		}
+	});
+	ProjectNodes(SubtreeNodes);
+
+	// Ancestors of the subtree keep their positions; their node counts did not change, and moving
+	// them would touch the splines of most edges in the graph.
+	SubtreeRoot.SetPosNonLeaf();
+	Edges.UpdateClusterPositions();
+}
+
+void AIGVGraphActor::QueryPickRays(TArray<FIGVPickRay> const& Rays,
+								   TArray<FIGVPickRayHit>& OutHits)
+{
+	PickRayQuery.SetNodePositions(Nodes);
+	PickRayQuery.Query(Rays, PickDistanceThreshold, SelectAllDistanceThreshold, OutHits);
+}
+
 void AIGVGraphActor::SetupEdgeMeshes()
 {
-	FGraphEventArray Tasks;
-	for (FIGVEdge& Edge : Edges)
-	{
-		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&]() {
-			// Edge.UpdateRenderGroup();
-			Edge.UpdateSplineControlPoints();
-		}));
-	}
-	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+	WaitForEdgeMeshUpdate();
 
 	DefaultEdgeGroupMeshComponent->Setup();
 	bUpdateDefaultEdgeMeshRequired = false;
@@ -522,58 +868,143 @@ void AIGVGraphActor::SetupEdgeMeshes()
 	RemainedEdgeGroupMeshComponent->Setup();
 }
 
-void AIGVGraphActor::UpdateEdgeMeshes()
+void AIGVGraphActor::SetupEdgeMeshes(TArray<FIGVEdge*> const& ChangedEdges)
+{
+	WaitForEdgeMeshUpdate();
+
+	// The control points of the changed edges were set up with their clusters. Only their splines
+	// are written, in spare splines for added edges, unless the Default component runs out of them.
+	DefaultEdgeGroupMeshComponent->UpdateChangedEdges(ChangedEdges);
+	bUpdateDefaultEdgeMeshRequired = false;
+
+	// Few edges, so they are rewritten; they are set up again only if their edge set changed
+	HighlightedEdgeGroupMeshComponent->Update();
+	RemainedEdgeGroupMeshComponent->Update();
+}
+
+void AIGVGraphActor::BeginEdgeMeshUpdate()
 {
-	EdgeUpdateTasks.Reset();
+	// Changes made on the game thread since the last update go to the render thread first
+	WaitForEdgeMeshUpdate();
+
+	EdgeMeshUpdateTask = FKWTask<>::ConstructAndDispatchWhenReady([this]() { UpdateEdgeMeshes(); });
+}
+
+void AIGVGraphActor::WaitForEdgeMeshUpdate()
+{
+	check(IsInGameThread());
+
+	if (EdgeMeshUpdateTask.IsValid())
+	{
+		WaitForEdgeMeshUpdateTask();
+		EdgeMeshUpdateTask = nullptr;
+	}
+
+	DefaultEdgeGroupMeshComponent->FlushRenderUpdates();
+	HighlightedEdgeGroupMeshComponent->FlushRenderUpdates();
+	RemainedEdgeGroupMeshComponent->FlushRenderUpdates();
+
+	// Moved out first, since an edit may wait again
+	TArray<TFunction<void()>> Edits = MoveTemp(EdgeMeshUpdateDeferredEdits);
+	for (TFunction<void()> const& Edit : Edits)
+	{
+		Edit();
+	}
+}
 
+void AIGVGraphActor::RunAfterEdgeMeshUpdate(TFunction<void()>&& Edit)
+{
+	check(IsInGameThread());
+
+	if (EdgeMeshUpdateTask.IsValid())
+	{
+		EdgeMeshUpdateDeferredEdits.Add(MoveTemp(Edit));
+	}
+	else
+	{
+		Edit();
+	}
+}
+
+void AIGVGraphActor::WaitForEdgeMeshUpdateTask() const
+{
+	if (EdgeMeshUpdateTask.IsValid() && !EdgeMeshUpdateTask->IsComplete())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(EdgeMeshUpdateTask);
+	}
+}
+
+// Runs on EdgeMeshUpdateTask
+void AIGVGraphActor::UpdateEdgeMeshes()
+{
 	if (bUpdateDefaultEdgeMeshRequired)
 	{
-		for (FIGVEdge& Edge : Edges)
-		{
-			EdgeUpdateTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady(
-				[&]() { Edge.UpdateDefaultSplineControlPoints(); }));
-		}
-		FTaskGraphInterface::Get().WaitUntilTasksComplete(EdgeUpdateTasks);
+		// The level parameters may have changed
+		Edges.UpdateClusterLevels();
 		DefaultEdgeGroupMeshComponent->Update();
 		bUpdateDefaultEdgeMeshRequired = false;
 
-		EdgeUpdateTasks.Reset();
-
-		for (FIGVEdge& Edge : Edges)
-		{
-			EdgeUpdateTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&]() {
-				Edge.UpdateRenderGroup();
-				Edge.UpdateSplineControlPoints();
+		KWParallelFor(Edges.Num(), [this](int32 const Begin, int32 const End) {
+			for (int32 DenseIdx = Begin; DenseIdx < End; DenseIdx++)
+			{
+				FIGVEdge& Edge = Edges[DenseIdx];
+				Edges.UpdateRenderGroup(Edge);
 				Edge.bUpdateMeshRequired = false;
-			}));
-		}
-		FTaskGraphInterface::Get().WaitUntilTasksComplete(EdgeUpdateTasks);
+			}
+		}, 256);
+		DefaultEdgeGroupMeshComponent->UpdateDrawRanges();
 		HighlightedEdgeGroupMeshComponent->Update();
 		RemainedEdgeGroupMeshComponent->Update();
 	}
 	else
 	{
+		TArray<FIGVEdge*> DirtyEdges;
 		for (FIGVEdge& Edge : Edges)
 		{
-			if (Edge.bUpdateMeshRequired)
+			if (Edge.bUpdateMeshRequired) DirtyEdges.Add(&Edge);
+		}
+
+		KWParallelFor(DirtyEdges.Num(), [this, &DirtyEdges](int32 const Begin, int32 const End) {
+			for (int32 Idx = Begin; Idx < End; Idx++)
 			{
-				EdgeUpdateTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&]() {
-					Edge.UpdateRenderGroup();
-					Edge.UpdateSplineControlPoints();
-					Edge.bUpdateMeshRequired = false;
-				}));
+				Edges.UpdateRenderGroup(*DirtyEdges[Idx]);
 			}
-		}
-		FTaskGraphInterface::Get().WaitUntilTasksComplete(EdgeUpdateTasks);
+		}, 256);
 
-		if (EdgeUpdateTasks.Num() > 0)
+		if (DirtyEdges.Num() > 0)
 		{
-			HighlightedEdgeGroupMeshComponent->Update();
-			RemainedEdgeGroupMeshComponent->Update();
+			// Only the dirty edges are rewritten unless the groups changed their edge sets
+			DefaultEdgeGroupMeshComponent->UpdateDrawRanges();
+			HighlightedEdgeGroupMeshComponent->UpdateDirtyEdges();
+			RemainedEdgeGroupMeshComponent->UpdateDirtyEdges();
+
+			for (FIGVEdge* const Edge : DirtyEdges)
+			{
+				Edge->bUpdateMeshRequired = false;
+			}
 		}
 	}
 }
 
+void AIGVGraphActor::UpdateEdgeLOD()
+{
+	AIGVPawn* const Pawn = UIGVFunctionLibrary::GetPawn(this);
+	if (Pawn == nullptr || Pawn->CameraComponent == nullptr) return;
+
+	// Only the Default group, which holds most of the edges
+	DefaultEdgeGroupMeshComponent->UpdateLOD(Pawn->CameraComponent->GetComponentLocation(),
+											 Pawn->CameraComponent->GetForwardVector());
+}
+
+void AIGVGraphActor::UpdateEdgeSampling()
+{
+	WaitForEdgeMeshUpdate();
+
+	DefaultEdgeGroupMeshComponent->UpdateSampling();
+	HighlightedEdgeGroupMeshComponent->UpdateSampling();
+	RemainedEdgeGroupMeshComponent->UpdateSampling();
+}
+
 void AIGVGraphActor::UpdateColors()
 {
 	int32 const NumNodes = Nodes.Num();
@@ -627,204 +1058,112 @@ void AIGVGraphActor::ResetAmbientOcclusion()
 
 void AIGVGraphActor::UpdateInteraction()
 {
-	bool ShowImages;
-	TArray<enum class EControllerHand> PickRayInformationKeys;
-	PickRayDistSortedNodesHandMap.GenerateKeyArray(PickRayInformationKeys);
-
-	IGV_LOG(Log, TEXT("PickRayInformationKeys: %d"), PickRayInformationKeys.Num());
-
-	UpdateNodeDistanceToPickRay(); // Can pull this into for loop?
+	UpdateNodeDistanceToPickRay();
 
-	for (auto HandKey : PickRayInformationKeys)
+	for (FIGVPickRayHit const& Hit : PickRayHits)
 	{
-		TArray<AIGVNodeActor*> PickRayDistSortedNodesHand;
-		if (HandKey == EControllerHand::Left)
-		{
-			PickRayDistSortedNodesHand = LeftPickRayDistSortedNodes;
-			ShowImages = ShowNodeImages;
-		}
-		else
-		{
-			 PickRayDistSortedNodesHand = RightPickRayDistSortedNodes;
-			 ShowImages = true;
-		}
-		//TArray<AIGVNodeActor*> PickRayDistSortedNodesHand = PickRayDistSortedNodesHandMap[HandKey].Nodes;
+		if (Hit.NearestNodeIdx == -1) continue;
 
-		if (PickRayDistSortedNodesHand.Num() == 0) continue;
-
-		IGV_LOG(Log, TEXT("PickRayDistSortedNodesHand: %d"), PickRayDistSortedNodesHand.Num());
-
-		AIGVNodeActor* const NearestNode = PickRayDistSortedNodesHand[0];
-		AIGVNodeActor* LastNearestNode = LastNearestNodeMap[HandKey];
+		EControllerHand const HandKey = Hit.Hand;
+		bool const ShowImages = (HandKey == EControllerHand::Left) ? ShowNodeImages : true;
 
+		int32 const HandIdx = FIGVInteractionState::HandIdx(HandKey);
+		int32 const NearestNodeIdx = Hit.NearestNodeIdx;
+		AIGVNodeActor* const NearestNode = Nodes[NearestNodeIdx];
 
 		// update nearest node
-		if (LastNearestNode != nullptr)
+		int32& HandNearestNodeIdx = Interaction.LastNearestNodeIdx[HandIdx];
+		if (HandNearestNodeIdx != NearestNodeIdx)
 		{
-			if (LastNearestNode != NearestNode)
+			if (HandNearestNodeIdx != -1)
 			{
-				LastNearestNodeMap[HandKey]->EndNearest(); // Does Nothing
-				LastNearestNodeMap[HandKey] = NearestNode;
-				LastNearestNodeMap[HandKey]->BeginNearest(); //Does Nothing
+				Nodes[HandNearestNodeIdx]->EndNearest(); // Does Nothing
 			}
-		}
-		else
-		{
-			LastNearestNodeMap[HandKey] = NearestNode;
-			LastNearestNodeMap[HandKey]->BeginNearest(); // Does Nothing
+			HandNearestNodeIdx = NearestNodeIdx;
+			NearestNode->BeginNearest(); // Does Nothing
 		}
 
-		AIGVNodeActor* LastPickedNode = LastPickedNodeMap[HandKey];
-
 		// update picked node
+		int32& HandPickedNodeIdx = Interaction.LastPickedNodeIdx[HandIdx];
 		if (NearestNode->IsPicked(HandKey))  // nearest node actor is picked node actor
 		{
-			if (LastPickedNode != nullptr)  // has previous picked node actor
+			if (HandPickedNodeIdx != -1)  // has previous picked node actor
 			{
-				IGV_LOG(Log, TEXT("LastPickedNode: %s"), *LastPickedNode->ToString());
-				if (LastPickedNode != NearestNode)  // different node picked
+				IGV_LOG(Log, TEXT("LastPickedNode: %s"), *Nodes[HandPickedNodeIdx]->ToString());
+				if (HandPickedNodeIdx != NearestNodeIdx)  // different node picked
 				{
-					LastPickedNodeMap[HandKey]->EndPicked(HandKey);
-					LastPickedNodeMap[HandKey] = NearestNode;
-					LastPickedNodeMap[HandKey]->BeginPicked(HandKey, ShowImages);
+					Nodes[HandPickedNodeIdx]->EndPicked(HandKey);
+					HandPickedNodeIdx = NearestNodeIdx;
+					NearestNode->BeginPicked(HandKey, ShowImages);
 				}
 			}
 			else  // new node actor picked
 			{
-				LastPickedNodeMap[HandKey] = NearestNode;
-				LastPickedNodeMap[HandKey]->BeginPicked(HandKey, ShowImages);
+				HandPickedNodeIdx = NearestNodeIdx;
+				NearestNode->BeginPicked(HandKey, ShowImages);
 			}
 		}
 		else
 		{
-			if (LastPickedNode != nullptr)
+			if (HandPickedNodeIdx != -1)
 			{
-				LastPickedNode->EndPicked(HandKey);
+				Nodes[HandPickedNodeIdx]->EndPicked(HandKey);
 			}
-			LastPickedNodeMap[HandKey] = nullptr;
+			HandPickedNodeIdx = -1;
 		}
 	}
-
-	//if (PickRayDistSortedNodes.Num() == 0) return;
-
-	//UpdateNodeDistanceToPickRay();
-	//AIGVNodeActor* const NearestNode = PickRayDistSortedNodes[0];
-
-	// update nearest node
-	//if (LastNearestNode != nullptr)  // has previous nearest node actor
-	//{
-	//	if (LastNearestNode != NearestNode)  // different node actor is nearest
-	//	{
-	//		LastNearestNode->EndNearest(); // Does Nothing
-	//		LastNearestNode = NearestNode;
-	//		LastNearestNode->BeginNearest(); //Does Nothing
-	//	}
-	//}
-	//else
-	//{
-	//	LastNearestNode = NearestNode;
-	//	LastNearestNode->BeginNearest(); // Does Nothing
-	//}
-
-	// update picked node
-	//if (NearestNode->IsPicked())  // nearest node actor is picked node actor
-	//{
-	//	if (LastPickedNode != nullptr)  // has previous picked node actor
-	//	{
-	//		if (LastPickedNode != NearestNode)  // different node picked
-	//		{
-	//			LastPickedNode->EndPicked();
-	//			LastPickedNode = NearestNode;
-	//			LastPickedNode->BeginPicked();
-	//		}
-	//	}
-	//	else  // new node actor picked
-	//	{
-	//		LastPickedNode = NearestNode;
-	//		LastPickedNode->BeginPicked();
-	//	}
-	//}
-	//else
-	//{
-	//	if (LastPickedNode != nullptr)
-	//	{
-	//		LastPickedNode->EndPicked();
-	//	}
-	//	LastPickedNode = nullptr;
-	//}
 }
 
 void AIGVGraphActor::UpdateNodeDistanceToPickRay()
 {
 	AIGVPawn* const Pawn = UIGVFunctionLibrary::GetPawn(this);
-	if (Pawn == nullptr) return;
-	TArray<enum class EControllerHand> PickRayInformationKeys;
-	Pawn->PickRayInformation.GenerateKeyArray(PickRayInformationKeys);
-
-	ShowNodeImages = !(Pawn->ShowNodeDetails);
-
-	for (auto HandKey : PickRayInformationKeys)
+	if (Pawn == nullptr)
 	{
-		auto PickRayInformation = Pawn->PickRayInformation[HandKey];
-		FVector Origin = PickRayInformation.Key;
-		FVector Direction = PickRayInformation.Value.Vector().GetSafeNormal();
-
-		for (AIGVNodeActor* const Node : Nodes)
-		{
-			Node->DistanceToPickRays[HandKey] = FMath::PointDistToLine(Node->GetActorLocation(), Direction, Origin);
-			Node->DistanceToPickRay = FMath::PointDistToLine(Node->GetActorLocation(), Direction, Origin);
-		}
+		// Without rays, nothing is hit, rather than what was hit last frame
+		PickRays.Reset();
+		PickRayHits.Reset();
+		Interaction.ResetDistancesToPickRay();
+		return;
+	}
 
-		if (HandKey == EControllerHand::Left)
-		{
-			LeftPickRayDistSortedNodes.Sort([&](AIGVNodeActor const& A, AIGVNodeActor const& B) {
-				return A.DistanceToPickRays[HandKey] < B.DistanceToPickRays[HandKey];
-			});
-		}
+	ShowNodeImages = !(Pawn->ShowNodeDetails);
 
-		if (HandKey == EControllerHand::Right)
-		{
-			RightPickRayDistSortedNodes.Sort([&](AIGVNodeActor const& A, AIGVNodeActor const& B) {
-				return A.DistanceToPickRays[HandKey] < B.DistanceToPickRays[HandKey];
-			});
-		}
-		//PickRayDistSortedNodesHandMap[HandKey].Nodes.Sort([&](AIGVNodeActor const& A, AIGVNodeActor const& B) {
-		//	return A.DistanceToPickRays[HandKey] < B.DistanceToPickRays[HandKey];
-		//});
+	Pawn->GetPickRays(PickRays);
+	QueryPickRays(PickRays, PickRayHits);
 
-		//PickRayDistSortedNodesHandMap[HandKey].Nodes.Sort([&](AIGVNodeActor const& A, AIGVNodeActor const& B) {
-		//	return A.DistanceToPickRays[HandKey] < B.DistanceToPickRays[HandKey];
-		//});
+	if (Nodes.Num() == 0) return;
 
-		/*Node->DistanceToPickRay = FMath::PointDistToLine(
-			Node->GetActorLocation(), Pawn->PickRayDirection, Pawn->PickRayOrigin);*/
+	for (int32 RayIdx = 0, NumRays = PickRays.Num(); RayIdx < NumRays; RayIdx++)
+	{
+		Interaction.SetDistancesToPickRay(PickRays[RayIdx].Hand,
+										  &PickRayQuery.Distances[RayIdx * PickRayQuery.NumPaddedNodes()]);
 	}
+}
 
-	/*LeftPickRayDistSortedNodes.Sort([](AIGVNodeActor const& A, AIGVNodeActor const& B) {
-		return A.DistanceToPickRays[EControllerHand::Left] < B.DistanceToPickRays[EControllerHand::Left];
-	});
-
-	RightPickRayDistSortedNodes.Sort([](AIGVNodeActor const& A, AIGVNodeActor const& B) {
-		return A.DistanceToPickRays[EControllerHand::Right] < B.DistanceToPickRays[EControllerHand::Right];
-	});*/
+AIGVNodeActor* AIGVGraphActor::GetLastNearestNode(EControllerHand const Hand) const
+{
+	int32 const NodeIdx = Interaction.LastNearestNodeIdx[FIGVInteractionState::HandIdx(Hand)];
+	return NodeIdx != -1 ? Nodes[NodeIdx] : nullptr;
+}
 
-	/*PickRayDistSortedNodes.Sort([](AIGVNodeActor const& A, AIGVNodeActor const& B) {
-		return A.DistanceToPickRay < B.DistanceToPickRay;
-	});*/
+AIGVNodeActor* AIGVGraphActor::GetLastPickedNode(EControllerHand const Hand) const
+{
+	int32 const NodeIdx = Interaction.LastPickedNodeIdx[FIGVInteractionState::HandIdx(Hand)];
+	return NodeIdx != -1 ? Nodes[NodeIdx] : nullptr;
 }
 
 /*void AIGVGraphActor::OnLeftMouseButtonReleased()
 {
-	if (LastPickedNodeMap[EControllerHand::Right] != nullptr)
+	if (GetLastPickedNode(EControllerHand::Right) != nullptr)
 	{
-		LastPickedNodeMap[EControllerHand::Right]->OnLeftMouseButtonReleased();
+		GetLastPickedNode(EControllerHand::Right)->OnLeftMouseButtonReleased();
 	}
 }*/
 
 void AIGVGraphActor::OnYReleased()
 {
 	auto Hand = EControllerHand::Left;
-	AIGVNodeActor* LastLeftPickedNode = LastPickedNodeMap[Hand];
+	AIGVNodeActor* LastLeftPickedNode = GetLastPickedNode(Hand);
 	if (LastLeftPickedNode != nullptr)
 	{
 		if (NodeBridgeQueue.IsEmpty())
@@ -944,62 +1283,20 @@ void AIGVGraphActor::OnLeftThumbstickPressed()
 		NodeBridgeQueue.Dequeue(SecondNode);
 		if (FirstNode != SecondNode)
 		{
-			for (const FIGVEdge &Edge : Edges) // originally for (auto const& Edge : Edges)
+			// Toggle the edge between the two nodes
+			FIGVEdgeHandle const Handle = Edges.Find(FirstNode->Idx, SecondNode->Idx);
+			if (Handle.IsSet())
 			{
-				if ((Edge.SourceNode == FirstNode && Edge.TargetNode == SecondNode) ||
-					(Edge.SourceNode == SecondNode && Edge.TargetNode == FirstNode))
-				{
-					IGV_LOG(Log, TEXT("Removing Edge: %s"), *Edge.ToString());
-
-					int32 EdgeIndex = Edges.Find(Edge);
-
-					IGV_LOG(Log, TEXT("Removing Edges Index: %d"), EdgeIndex);
-
-					Edge.SourceNode->Neighbors.Remove(Edge.TargetNode);
-					Edge.TargetNode->Neighbors.Remove(Edge.SourceNode);
-
-					IGV_LOG(Log, TEXT("Node Neighbors Removed"));
-
-					Edge.SourceNode->Edges.Remove(&Edges[EdgeIndex]);
-					Edge.TargetNode->Edges.Remove(&Edges[EdgeIndex]);
-
-					IGV_LOG(Log, TEXT("Node Edges Removed"));
-
-					Edges.RemoveAt(EdgeIndex);
-
-					NodeBridgeQueue.Empty();
-
-					RedrawGraph();
-
-					return;
-				}
+				RemoveEdge(Handle);
+			}
+			else
+			{
+				AddEdge(FirstNode->Idx, SecondNode->Idx);
 			}
-			FIGVEdge Edge = FIGVEdge::FIGVEdge(this);
-			const int32 SourceIndex = FirstNode->Idx;
-			const int32 TargetIndex = SecondNode->Idx;
-
-			Edge.SourceIdx = SourceIndex;
-			Edge.TargetIdx = TargetIndex;
-
-			Edges.Emplace(Edge);
-
-			//FIGVEdge& Edgey = Edges[Edges.Num() - 1];
-			FIGVEdge& Edgey = Edges.Last();
-
-			Edgey.SourceNode = Nodes[Edgey.SourceIdx];
-			Edgey.TargetNode = Nodes[Edgey.TargetIdx];
-
-			Edgey.SourceNode->Edges.Add(&Edgey);
-			Edgey.TargetNode->Edges.Add(&Edgey);
-
-			Edgey.SourceNode->Neighbors.Add(Edgey.TargetNode);
-			Edgey.TargetNode->Neighbors.Add(Edgey.SourceNode);
-
-			IGV_LOG(Log, TEXT("Created Edge: %s"), *Edge.ToString());
 
 			NodeBridgeQueue.Empty();
 
-			RedrawGraph();
+			RedrawGraphAfterEdgeEdit(FirstNode->Idx, SecondNode->Idx);
 		}
 	}
 }
@@ -1015,29 +1312,14 @@ void AIGVGraphActor::OnLeftThumbstickDoublePressed()
 		NodeBridgeQueue.Dequeue(SecondNode);
 		if (FirstNode != SecondNode)
 		{
-			for (FIGVEdge const& Edge : Edges) //const FIGVEdge&
+			FIGVEdgeHandle const Handle = Edges.Find(FirstNode->Idx, SecondNode->Idx);
+			if (Handle.IsSet())
 			{
-				if ((Edge.SourceNode == FirstNode && Edge.TargetNode == SecondNode) ||
-					(Edge.SourceNode == SecondNode && Edge.TargetNode == FirstNode))
-				{
-					IGV_LOG(Log, TEXT("Removing Edge: %s"), *Edge.ToString());
-
-					FIGVEdge* Edgey = (FIGVEdge*) &Edge;
-
-					Edge.SourceNode->Edges.Remove(Edgey);
-					Edge.TargetNode->Edges.Remove(Edgey);
-
-					Edge.SourceNode->Neighbors.Remove(Edge.TargetNode);
-					Edge.TargetNode->Neighbors.Remove(Edge.SourceNode);
-
-					Edges.Remove(Edge);
+				RemoveEdge(Handle);
 
-					NodeBridgeQueue.Empty();
+				NodeBridgeQueue.Empty();
 
-					RedrawGraph();
-
-					break;
-				}
+				RedrawGraphAfterEdgeEdit(FirstNode->Idx, SecondNode->Idx);
 			}
 		}
 	}
@@ -1047,10 +1329,10 @@ void AIGVGraphActor::OnLeftThumbstickDoublePressed()
 void AIGVGraphActor::OnLeftXCapTouch()
 {
 	auto Hand = EControllerHand::Left;
-	if (LastPickedNodeMap[Hand] != nullptr)
+	if (GetLastPickedNode(Hand) != nullptr)
 	{
 		AIGVPawn* const Pawn = UIGVFunctionLibrary::GetPawn(this);
-		Pawn->UpdateNodeDetailsWidget(LastPickedNodeMap[Hand]);
+		Pawn->UpdateNodeDetailsWidget(GetLastPickedNode(Hand));
 	}
 }
 
@@ -1058,11 +1340,11 @@ void AIGVGraphActor::OnLeftTriggerButtonReleased()
 {
 	ResetQueue();
 	auto Hand = EControllerHand::Left;
-	if (LastPickedNodeMap[Hand] != nullptr)
+	if (GetLastPickedNode(Hand) != nullptr)
 	{
-		LastPickedNodeMap[Hand]->OnLeftTriggerButtonReleased();
+		GetLastPickedNode(Hand)->OnLeftTriggerButtonReleased();
 	}
-	else if (!LastNearestNodeMap[Hand]->IsNearPicked())
+	else if (!GetLastNearestNode(Hand)->IsNearPicked(Hand))
 	{
 		for (AIGVNodeActor* Node : Nodes)
 		{
@@ -1075,11 +1357,11 @@ void AIGVGraphActor::OnLeftTriggerButtonReleased()
 void AIGVGraphActor::OnRightTriggerButtonReleased()
 {
 	auto Hand = EControllerHand::Right;
-	if (LastPickedNodeMap[Hand] != nullptr)
+	if (GetLastPickedNode(Hand) != nullptr)
 	{
-		LastPickedNodeMap[Hand]->OnRightTriggerButtonReleased();
+		GetLastPickedNode(Hand)->OnRightTriggerButtonReleased();
 	}
-	else if(!LastNearestNodeMap[Hand]->IsNearPicked())
+	else if(!GetLastNearestNode(Hand)->IsNearPicked(Hand))
 	{
 		for (AIGVNodeActor* Node : Nodes)
 		{
@@ -1112,9 +1394,9 @@ void AIGVGraphActor::OnLeftGripPressed(FVector PickRayOrigin, FRotator PickRayRo
 	//SetActorRelativeRotation(NewRotation);
 	//RootComponent->AddLocalRotation(PickRayRotation, false);
 	auto Hand = EControllerHand::Left;
-	if (LastPickedNodeMap[Hand] != nullptr)
+	if (GetLastPickedNode(Hand) != nullptr)
 	{
-		LastPickedNodeMap[Hand]->OnLeftGripPressed(PickRayOrigin, PickRayRotation);
+		GetLastPickedNode(Hand)->OnLeftGripPressed(PickRayOrigin, PickRayRotation);
 	}
 }
 
@@ -1239,10 +1521,10 @@ void AIGVGraphActor::OnResponseReceivedEdge(FHttpRequestPtr Request, FHttpRespon
 			int32 targetIdx = NeoMap[NeoResponse.results[0].data[i].meta[1].id];
 			IGV_LOG(Log, TEXT("Source: %d, Target: %d"), sourceIdx, targetIdx);
 
-			FIGVEdge Edge = FIGVEdge::FIGVEdge(this);
+			FIGVEdge Edge;
 			Edge.SourceIdx = sourceIdx;
 			Edge.TargetIdx = targetIdx;
-			Edges.Emplace(Edge);
+			Edges.Add(MoveTemp(Edge));
 		}
 	}
 	SetupGraph();
@@ -1270,7 +1552,7 @@ void AIGVGraphActor::ToggleFOV()
 	{
 		FieldOfView += 10;
 	}
-	UpdateTreemapLayout();
+	UpdateViewExtent();
 }
 
 void AIGVGraphActor::ToggleAspectRatio()
@@ -1311,7 +1593,7 @@ void AIGVGraphActor::ToggleAspectRatio()
 			break;
 	}
 
-	UpdateTreemapLayout();
+	UpdateViewExtent();
 }
 
 FString AIGVGraphActor::AspectRatioToString()
@@ -7,6 +7,12 @@
 
 #include "IGVCluster.h"
 #include "IGVEdge.h"
+#include "IGVEdgeStore.h"
+#include "IGVFrameGovernor.h"
+#include "IGVHighlightTransitionAnimator.h"
+#include "IGVGraphStatistics.h"
+#include "IGVInteractionState.h"
+#include "IGVPickRay.h"
 #include "IGVProjection.h"
 
 #include "Runtime/Online/HTTP/Public/Http.h" //DPK Added
@@ -22,13 +28,6 @@
 
 #include "IGVGraphActor.generated.h"
 
-USTRUCT()
-struct FPickRaySortedNodesArray {
-	GENERATED_USTRUCT_BODY()
-
-	TArray<class AIGVNodeActor*> Nodes;
-};
-
 enum class AREnum : uint8
 {
 	Square,
@@ -79,13 +78,23 @@ public:
 
 public:
 	TArray<class AIGVNodeActor*> Nodes;
-	TArray<FIGVEdge> Edges;
+	FIGVEdgeStore Edges;
 	TArray<FIGVCluster> Clusters;
 	FIGVCluster* RootCluster;
 	TMap<int32, int32> NeoMap;
 
 	FVector2D PlanarExtent;
 
+	// Bounds of the treemap positions, which NormalizeNodePosition maps to [-1, 1]
+	FVector2D NormalizationOffset;
+	FVector2D NormalizationExtent;
+
+	// Eases PlanarExtent to a new field of view or aspect ratio, see UpdateViewExtent
+	FVector2D PlanarExtentBeforeTransition;
+	FVector2D PlanarExtentAfterTransition;
+	float ViewTransitionTime;
+	bool bInViewTransition;
+
 	Quality *q;
 
 	AREnum AspectRatioEnum;
@@ -120,6 +129,15 @@ public:
 		Category = ImmersiveGraphVisualization)
 		float TreemapNesting;
 
+	// Lays out sibling subtrees of the treemap concurrently. Either way, the random weights and
+	// offsets of each cluster are drawn from a stream seeded with TreemapRandomSeed and its index,
+	// so both give the same layout for the same seed.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		bool bParallelTreemapLayout;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		int32 TreemapRandomSeed;
+
 	UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, SaveGame,
 		Category = ImmersiveGraphVisualization)
 		int32 EdgeSplineResolution;
@@ -133,6 +151,84 @@ public:
 		meta = (ClampMin = "2", ClampMax = "32", UIMin = "2", UIMax = "32"))
 		int32 EdgeNumSides;
 
+	// Draw edge tubes from one shared 16-bit index template instead of a full index buffer
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		bool bEdgeIndexTemplate;
+
+	// Skip chunks of edge segments outside the view frustum of each eye. Off by default: the chunk
+	// bounds come from FIGVEdgeMeshTessellator, the CPU model of the spline shader, and assume the
+	// shader bundles and widens the tubes the same way. They have not been checked against the GPU
+	// path, where any difference makes edges pop at the border of the view.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		bool bCullEdgeChunks;
+
+	// Padding of the edge chunk bounds, relative to the sphere radius, for differences between
+	// the tessellator and the shader
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0", UIMin = "0", UIMax = "0.2"))
+		float EdgeChunkBoundsMargin;
+
+	// View-dependent level of detail of the Default edge group: chunks of edge segments away from
+	// the gaze direction, or small in view, use 1/2, 1/4 or 1/8 of EdgeSplineResolution samples.
+	// Requires bEdgeIndexTemplate.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		bool bEdgeLOD;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0", ClampMax = "180", UIMin = "0", UIMax = "180"))
+		float EdgeLODFoveaAngle;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0", ClampMax = "180", UIMin = "0", UIMax = "180"))
+		float EdgeLODPeripheryAngle;
+
+	// Chunks spanning a smaller angle drop one more level
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0", ClampMax = "180", UIMin = "0", UIMax = "180"))
+		float EdgeLODMinAngularSize;
+
+	// Sample nearly straight edge segments with 1/2, 1/4 or 1/8 of EdgeSplineResolution samples,
+	// as long as they stay within EdgeSampleTolerance of the exact curve. Requires
+	// bEdgeIndexTemplate.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		bool bAdaptiveEdgeSampling;
+
+	// Largest distance between a sampled edge and its exact curve, relative to EdgeWidth
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0", UIMin = "0", UIMax = "4"))
+		float EdgeSampleTolerance;
+
+	// Vertices of all edge tubes at full view detail. The tolerance is raised until adaptive
+	// sampling fits, so segments are coarsened in the order of their curvature. 0 for no limit.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0"))
+		int32 EdgeVertexBudget;
+
+	// Coarsen the edges while frames take longer than GovernorTargetFrameRate allows, see
+	// FIGVFrameGovernor. Decisions show in "stat IGV".
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		bool bFrameGovernor;
+
+	// Refresh rate of the headset
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "1", UIMin = "30", UIMax = "144"))
+		float GovernorTargetFrameRate;
+
+	// Animate highlight transitions together with FIGVHighlightTransitionAnimator rather than with
+	// the Blueprint timeline of each node
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization)
+		bool bBatchedHighlightTransitions;
+
+	// Seconds, for the batched transitions
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0"))
+		float HighlightTransitionDuration;
+
+	// Seconds, for changes of the field of view or aspect ratio
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraphVisualization,
+		meta = (ClampMin = "0"))
+		float ViewTransitionDuration;
+
 	UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, SaveGame,
 		Category = ImmersiveGraphVisualization)
 		float EdgeBundlingStrength;
@@ -157,9 +253,17 @@ public:
 		Category = ImmersiveGraphVisualization)
 		float ColorLuminance;
 
-	TArray<class AIGVNodeActor*> PickRayDistSortedNodes;
-	class AIGVNodeActor* LastNearestNode;
-	class AIGVNodeActor* LastPickedNode;
+	FIGVPickRayQuery PickRayQuery;
+	TArray<FIGVPickRay> PickRays;
+	TArray<FIGVPickRayHit> PickRayHits;
+
+	FIGVInteractionState Interaction;
+
+	FIGVGraphStatistics Statistics;
+
+	FIGVFrameGovernor FrameGovernor;
+
+	FIGVHighlightTransitionAnimator HighlightTransitionAnimator;
 
 	UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, SaveGame,
 		Category = ImmersiveGraphVisualization)
@@ -178,7 +282,12 @@ public:
 	UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraph)
 		float NeighborHighlightedLevelScale;
 
-	FGraphEventArray EdgeUpdateTasks;
+	// Edge meshes are updated on a task from the end of a tick to the start of the next,
+	// overlapping the rest of the frame. Changes of edges and edge mesh settings on the game thread
+	// wait for it with WaitForEdgeMeshUpdate. Node state that it reads is changed through
+	// RunAfterEdgeMeshUpdate instead, which queues the change while the task runs.
+	FGraphEventRef EdgeMeshUpdateTask;
+	TArray<TFunction<void()>> EdgeMeshUpdateDeferredEdits;
 	bool bUpdateDefaultEdgeMeshRequired;
 	FString AspectRatioToString();
 
@@ -187,6 +296,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
@@ -206,6 +316,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 		FVector Project(FVector2D const& P) const;
 
+	// Projects the nodes in one batch, see ProjectToSphere, then places them
+	void ProjectNodes(TArray<class AIGVNodeActor*> const& ProjectedNodes);
+
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 		void UpdatePlanarExtent();
 
@@ -215,6 +328,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 		void UpdateTreemapLayout();
 
+	// Rescales the last treemap layout to the current FieldOfView and AspectRatio instead of laying
+	// out the graph again, so the layout is kept and only the nodes are projected again
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+		void UpdateViewExtent();
+
+	// Tests every ray against every node in a single pass over the node positions
+	void QueryPickRays(TArray<FIGVPickRay> const& Rays, TArray<FIGVPickRayHit>& OutHits);
+
 	/*UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 		void OnLeftMouseButtonReleased();*/
 
@@ -260,12 +381,8 @@ public:
 
 	/*DPK Splitting up the Left and Right controller pick rays*/
 	TMap<FString, class AIGVNodeActor*> LastPickedNodes;
-	TMap<enum class EControllerHand, struct FPickRaySortedNodesArray> PickRayDistSortedNodesHandMap;
-	TArray<class AIGVNodeActor*> LeftPickRayDistSortedNodes;
-	TArray<class AIGVNodeActor*> RightPickRayDistSortedNodes;
-	//TMap<enum class EControllerHand, TArray<class AIGVNodeActor*> > PickRayDistSortedNodesHandMap;
-	TMap<enum class EControllerHand, class AIGVNodeActor*> LastNearestNodeMap;
-	TMap<enum class EControllerHand, class AIGVNodeActor*> LastPickedNodeMap;
+	class AIGVNodeActor* GetLastNearestNode(enum class EControllerHand Hand) const;
+	class AIGVNodeActor* GetLastPickedNode(enum class EControllerHand Hand) const;
 	//TCircularQueue<class AIGVNodeActor*>(3) NodeBridgeQueue;
 	TCircularQueue<class AIGVNodeActor*> NodeBridgeQueue = TCircularQueue<class AIGVNodeActor*>(3);
 	void ResetQueue();
@@ -273,14 +390,36 @@ public:
 	void ToggleFOV();
 	void ToggleAspectRatio();
 
+	// Resamples the edge meshes after the sampling settings or the governor's level changed
+	void UpdateEdgeSampling();
+
+	// Waits for the edge mesh update of the last tick and sends its results to the render thread
+	void WaitForEdgeMeshUpdate();
+	void WaitForEdgeMeshUpdateTask() const;  // Only waits, so also off the game thread
+
+	// Runs Edit now, or after the running edge mesh update was picked up at the start of the next
+	// tick, in the order of the calls
+	void RunAfterEdgeMeshUpdate(TFunction<void()>&& Edit);
+
 protected:
 	void SetupNodes();
 	void SetupEdges();
+
+	// Edits of the edge set that keep the node edge and neighbor lists in sync
+	FIGVEdgeHandle AddEdge(int32 const SourceIdx, int32 const TargetIdx);
+	void RemoveEdge(FIGVEdgeHandle const Handle);
+
 	void SetupClusters();
 	void ConstructClusters();
 
 	void SetupEdgeMeshes();
+	void SetupEdgeMeshes(TArray<FIGVEdge*> const& ChangedEdges);
+	void BeginEdgeMeshUpdate();
 	void UpdateEdgeMeshes();
+	void UpdateEdgeLOD();
+
+	void UpdateViewTransition(float const DeltaTime);
+	void SetPlanarExtent(FVector2D const& NewPlanarExtent);
 
 	void UpdateColors();
 
@@ -293,6 +432,16 @@ protected:
 
 	void ResetGraph();
 	void RedrawGraph();
+
+	// Incremental counterpart of RedrawGraph after edges between two nodes were added or removed.
+	// The clustering hierarchy is kept; each endpoint may move to the sibling cluster with the
+	// best modularity gain, after which only the subtree spanning the old and new clusters is
+	// laid out again and only the edges touching that subtree are remeshed.
+	void RedrawGraphAfterEdgeEdit(int32 const NodeIdxA, int32 const NodeIdxB);
+
+	FIGVCluster* FindBestClusterForNode(int32 const NodeIdx);
+	void MoveLeafCluster(FIGVCluster& Leaf, FIGVCluster& NewParent);
+	void UpdateSubtreeTreemapLayout(FIGVCluster& SubtreeRoot);
 };
 
 USTRUCT()
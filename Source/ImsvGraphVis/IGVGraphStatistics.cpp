@@ -0,0 +1,259 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVGraphStatistics.h"
+
+#include "IGVGraphActor.h"
+#include "IGVNodeActor.h"
+
+FIGVGraphStatistics::FIGVGraphStatistics(AIGVGraphActor* const InGraphActor)
+	: GraphActor(InGraphActor),
+	  NumPicked(0),
+	  Degrees(),
+	  DegreeHistogram(),
+	  MaxDegree(0),
+	  ComponentParents(),
+	  NumComponents(0),
+	  CommunityInternal(),
+	  CommunityTotal(),
+	  SumInternal(0),
+	  SumTotalSquared(0),
+	  NumClusters(0)
+{
+}
+
+void FIGVGraphStatistics::Reset(int32 const NumNodes)
+{
+	NumPicked = 0;
+
+	Degrees.Init(0, NumNodes);
+	DegreeHistogram.Init(0, 1);
+	DegreeHistogram[0] = NumNodes;
+	MaxDegree = 0;
+
+	ComponentParents.Reset();
+	for (int32 Idx = 0; Idx < NumNodes; Idx++)
+	{
+		ComponentParents.Add(Idx);
+	}
+	NumComponents = NumNodes;
+
+	CommunityInternal.Reset();
+	CommunityTotal.Reset();
+	SumInternal = 0;
+	SumTotalSquared = 0;
+	NumClusters = 0;
+}
+
+void FIGVGraphStatistics::Rebuild()
+{
+	int32 const NumNodes = GraphActor->Nodes.Num();
+	int32 const NumClusterSlots = GraphActor->Clusters.Num();
+
+	Degrees.Init(0, NumNodes);
+	for (FIGVEdge const& Edge : GraphActor->Edges)
+	{
+		Degrees[Edge.SourceIdx]++;
+		Degrees[Edge.TargetIdx]++;
+	}
+
+	MaxDegree = 0;
+	for (int32 const Degree : Degrees)
+	{
+		MaxDegree = FMath::Max(MaxDegree, Degree);
+	}
+	DegreeHistogram.Init(0, MaxDegree + 1);
+	for (int32 const Degree : Degrees)
+	{
+		DegreeHistogram[Degree]++;
+	}
+
+	CommunityInternal.Init(0, NumClusterSlots);
+	CommunityTotal.Init(0, NumClusterSlots);
+	SumInternal = 0;
+	SumTotalSquared = 0;
+
+	for (int32 NodeIdx = 0; NodeIdx < NumNodes; NodeIdx++)
+	{
+		int32 const CommunityIdx = CommunityOf(NodeIdx);
+		if (CommunityIdx != -1)
+		{
+			CommunityTotal[CommunityIdx] += Degrees[NodeIdx];
+		}
+	}
+	for (int64 const Total : CommunityTotal)
+	{
+		SumTotalSquared += double(Total) * Total;
+	}
+
+	for (FIGVEdge const& Edge : GraphActor->Edges)
+	{
+		int32 const CommunityIdx = CommunityOf(Edge.SourceIdx);
+		if (CommunityIdx != -1 && CommunityIdx == CommunityOf(Edge.TargetIdx))
+		{
+			CommunityInternal[CommunityIdx] += 2;
+			SumInternal += 2;
+		}
+	}
+
+	NumClusters = 0;
+	for (FIGVCluster const& Cluster : GraphActor->Clusters)
+	{
+		if (!Cluster.IsLeaf()) NumClusters++;
+	}
+
+	RebuildComponents();
+}
+
+void FIGVGraphStatistics::OnEdgeAdded(int32 const SourceIdx, int32 const TargetIdx)
+{
+	AddDegree(SourceIdx, 1);
+	AddDegree(TargetIdx, 1);
+
+	int32 const CommunityIdx = CommunityOf(SourceIdx);
+	if (CommunityIdx != -1 && CommunityIdx == CommunityOf(TargetIdx))
+	{
+		CommunityInternal[CommunityIdx] += 2;
+		SumInternal += 2;
+	}
+
+	UnionComponents(SourceIdx, TargetIdx);
+}
+
+void FIGVGraphStatistics::OnEdgeRemoved(int32 const SourceIdx, int32 const TargetIdx)
+{
+	AddDegree(SourceIdx, -1);
+	AddDegree(TargetIdx, -1);
+
+	int32 const CommunityIdx = CommunityOf(SourceIdx);
+	if (CommunityIdx != -1 && CommunityIdx == CommunityOf(TargetIdx))
+	{
+		CommunityInternal[CommunityIdx] -= 2;
+		SumInternal -= 2;
+	}
+
+	// Union-find cannot split a component
+	RebuildComponents();
+}
+
+void FIGVGraphStatistics::OnNodeMoved(int32 const NodeIdx, int32 const OldCommunityIdx,
+									  int32 const NewCommunityIdx)
+{
+	int32 NumOldLinks = 0;
+	int32 NumNewLinks = 0;
+	int32 NumSelfLinks = 0;  // A self loop is listed twice in the node's edges
+
+	for (FIGVEdge const* const Edge : GraphActor->Nodes[NodeIdx]->Edges)
+	{
+		int32 const OtherIdx = Edge->SourceIdx == NodeIdx ? Edge->TargetIdx : Edge->SourceIdx;
+		if (OtherIdx == NodeIdx)
+		{
+			NumSelfLinks++;
+			continue;
+		}
+
+		int32 const OtherCommunityIdx = CommunityOf(OtherIdx);
+		NumOldLinks += (OtherCommunityIdx == OldCommunityIdx);
+		NumNewLinks += (OtherCommunityIdx == NewCommunityIdx);
+	}
+
+	int64 const OldDelta = 2 * NumOldLinks + NumSelfLinks;
+	int64 const NewDelta = 2 * NumNewLinks + NumSelfLinks;
+	CommunityInternal[OldCommunityIdx] -= OldDelta;
+	CommunityInternal[NewCommunityIdx] += NewDelta;
+	SumInternal += NewDelta - OldDelta;
+
+	AddCommunityTotal(OldCommunityIdx, -Degrees[NodeIdx]);
+	AddCommunityTotal(NewCommunityIdx, Degrees[NodeIdx]);
+}
+
+void FIGVGraphStatistics::OnPickedChanged(bool const bPicked)
+{
+	NumPicked += bPicked ? 1 : -1;
+	check(NumPicked >= 0);
+}
+
+float FIGVGraphStatistics::GetModularity() const
+{
+	double const TotalWeight = 2.0 * GraphActor->Edges.Num();
+	if (TotalWeight == 0) return 0.f;
+
+	return SumInternal / TotalWeight - SumTotalSquared / (TotalWeight * TotalWeight);
+}
+
+int32 FIGVGraphStatistics::CommunityOf(int32 const NodeIdx) const
+{
+	TArray<FIGVCluster> const& Clusters = GraphActor->Clusters;
+	if (!Clusters.IsValidIndex(NodeIdx) || Clusters[NodeIdx].NodeIdx != NodeIdx) return -1;
+
+	int32 const ParentIdx = Clusters[NodeIdx].ParentIdx;
+	return CommunityTotal.IsValidIndex(ParentIdx) ? ParentIdx : -1;
+}
+
+void FIGVGraphStatistics::AddDegree(int32 const NodeIdx, int32 const Delta)
+{
+	int32& Degree = Degrees[NodeIdx];
+	DegreeHistogram[Degree]--;
+	Degree += Delta;
+
+	if (Degree >= DegreeHistogram.Num())
+	{
+		DegreeHistogram.AddZeroed(Degree + 1 - DegreeHistogram.Num());
+	}
+	DegreeHistogram[Degree]++;
+
+	MaxDegree = FMath::Max(MaxDegree, Degree);
+	while (MaxDegree > 0 && DegreeHistogram[MaxDegree] == 0)
+	{
+		MaxDegree--;
+	}
+
+	AddCommunityTotal(CommunityOf(NodeIdx), Delta);
+}
+
+void FIGVGraphStatistics::AddCommunityTotal(int32 const CommunityIdx, int64 const Delta)
+{
+	if (CommunityIdx == -1) return;
+
+	int64& Total = CommunityTotal[CommunityIdx];
+	SumTotalSquared -= double(Total) * Total;
+	Total += Delta;
+	SumTotalSquared += double(Total) * Total;
+}
+
+void FIGVGraphStatistics::RebuildComponents()
+{
+	int32 const NumNodes = GraphActor->Nodes.Num();
+
+	ComponentParents.Reset(NumNodes);
+	for (int32 Idx = 0; Idx < NumNodes; Idx++)
+	{
+		ComponentParents.Add(Idx);
+	}
+	NumComponents = NumNodes;
+
+	for (FIGVEdge const& Edge : GraphActor->Edges)
+	{
+		UnionComponents(Edge.SourceIdx, Edge.TargetIdx);
+	}
+}
+
+int32 FIGVGraphStatistics::FindComponent(int32 NodeIdx)
+{
+	while (ComponentParents[NodeIdx] != NodeIdx)
+	{
+		// Path halving
+		ComponentParents[NodeIdx] = ComponentParents[ComponentParents[NodeIdx]];
+		NodeIdx = ComponentParents[NodeIdx];
+	}
+	return NodeIdx;
+}
+
+void FIGVGraphStatistics::UnionComponents(int32 const NodeIdxA, int32 const NodeIdxB)
+{
+	int32 const RootA = FindComponent(NodeIdxA);
+	int32 const RootB = FindComponent(NodeIdxB);
+	if (RootA == RootB) return;
+
+	ComponentParents[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+	NumComponents--;
+}
@@ -0,0 +1,80 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Graph statistics kept up to date from load, edit and highlight events so that the graph details
+// widget can read them in constant time. Modularity is measured on the communities formed by the
+// parents of the leaf clusters; parallel edges count as edge weight.
+class IMSVGRAPHVIS_API FIGVGraphStatistics
+{
+	class AIGVGraphActor* const GraphActor;
+
+	int32 NumPicked;
+
+	TArray<int32> Degrees;
+	TArray<int32> DegreeHistogram;  // Number of nodes per degree
+	int32 MaxDegree;
+
+	TArray<int32> ComponentParents;  // Union-find forest
+	int32 NumComponents;
+
+	TArray<int64> CommunityInternal;  // Twice the number of edges inside, per cluster
+	TArray<int64> CommunityTotal;	 // Sum of degrees, per cluster
+	int64 SumInternal;
+	double SumTotalSquared;
+	int32 NumClusters;
+
+public:
+	FIGVGraphStatistics(class AIGVGraphActor* const InGraphActor);
+
+	// New set of nodes; clears everything including the picked count
+	void Reset(int32 const NumNodes);
+
+	// Recomputes the edge and cluster statistics from scratch, e.g. after reclustering
+	void Rebuild();
+
+	void OnEdgeAdded(int32 const SourceIdx, int32 const TargetIdx);
+	void OnEdgeRemoved(int32 const SourceIdx, int32 const TargetIdx);  // After removal
+	void OnNodeMoved(int32 const NodeIdx, int32 const OldCommunityIdx,
+					 int32 const NewCommunityIdx);  // Before the hierarchy is changed
+	void OnPickedChanged(bool const bPicked);
+
+	FORCEINLINE int32 GetNumPicked() const
+	{
+		return NumPicked;
+	}
+
+	FORCEINLINE int32 GetMaxDegree() const
+	{
+		return MaxDegree;
+	}
+
+	FORCEINLINE TArray<int32> const& GetDegreeHistogram() const
+	{
+		return DegreeHistogram;
+	}
+
+	FORCEINLINE int32 GetNumComponents() const
+	{
+		return NumComponents;
+	}
+
+	FORCEINLINE int32 GetNumClusters() const
+	{
+		return NumClusters;
+	}
+
+	float GetModularity() const;
+
+protected:
+	int32 CommunityOf(int32 const NodeIdx) const;
+
+	void AddDegree(int32 const NodeIdx, int32 const Delta);
+	void AddCommunityTotal(int32 const CommunityIdx, int64 const Delta);
+
+	void RebuildComponents();
+	int32 FindComponent(int32 NodeIdx);
+	void UnionComponents(int32 const NodeIdxA, int32 const NodeIdxB);
+};
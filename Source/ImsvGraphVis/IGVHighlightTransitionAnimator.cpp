@@ -0,0 +1,88 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVHighlightTransitionAnimator.h"
+
+#include "IGVEdge.h"
+#include "IGVGraphActor.h"
+#include "IGVNodeActor.h"
+
+FIGVHighlightTransitionAnimator::FIGVHighlightTransitionAnimator(
+	AIGVGraphActor* const InGraphActor)
+	: GraphActor(InGraphActor), Nodes(), ElapsedTimes(), Edges(), EdgeAlphas(), EdgeIdxs()
+{
+}
+
+void FIGVHighlightTransitionAnimator::Begin(AIGVNodeActor* const Node)
+{
+	// Moved to the end, since its edges now blend towards its new levels
+	int32 const Idx = Nodes.Find(Node);
+	if (Idx != INDEX_NONE)
+	{
+		Nodes.RemoveAt(Idx, 1, false);
+		ElapsedTimes.RemoveAt(Idx, 1, false);
+	}
+
+	Nodes.Add(Node);
+	ElapsedTimes.Add(0.f);
+}
+
+void FIGVHighlightTransitionAnimator::Update(float const DeltaTime)
+{
+	if (!IsAnimating()) return;
+
+	float const Duration = FMath::Max(GraphActor->HighlightTransitionDuration, KINDA_SMALL_NUMBER);
+
+	Edges.Reset();
+	EdgeAlphas.Reset();
+	EdgeIdxs.Reset();
+
+	int32 NumActiveNodes = 0;
+	for (int32 NodeIdx = 0; NodeIdx < Nodes.Num(); NodeIdx++)
+	{
+		AIGVNodeActor* const Node = Nodes[NodeIdx];
+		float const ElapsedTime = ElapsedTimes[NodeIdx] + DeltaTime;
+		float const Alpha =
+			FMath::InterpEaseInOut(0.f, 1.f, FMath::Min(ElapsedTime / Duration, 1.f), 2.f);
+
+		Node->LevelScale =
+			FMath::Lerp(Node->LevelScaleBeforeTransition, Node->LevelScaleAfterTransition, Alpha);
+		Node->UpdateLocation();  // Pos3D is unchanged
+
+		// Later transitions overwrite the progress of shared edges
+		for (FIGVEdge* const Edge : Node->Edges)
+		{
+			int32 const* const EdgeIdx = EdgeIdxs.Find(Edge);
+			if (EdgeIdx)
+			{
+				EdgeAlphas[*EdgeIdx] = Alpha;
+			}
+			else
+			{
+				EdgeIdxs.Add(Edge, Edges.Add(Edge));
+				EdgeAlphas.Add(Alpha);
+			}
+		}
+
+		// Finished transitions are dropped in place, keeping the order of the others
+		if (ElapsedTime < Duration)
+		{
+			Nodes[NumActiveNodes] = Node;
+			ElapsedTimes[NumActiveNodes] = ElapsedTime;
+			NumActiveNodes++;
+		}
+	}
+
+	Nodes.SetNum(NumActiveNodes, false);
+	ElapsedTimes.SetNum(NumActiveNodes, false);
+
+	GraphActor->Edges.UpdateTransitions(Edges, EdgeAlphas);
+}
+
+void FIGVHighlightTransitionAnimator::Reset()
+{
+	Nodes.Empty();
+	ElapsedTimes.Empty();
+	Edges.Empty();
+	EdgeAlphas.Empty();
+	EdgeIdxs.Empty();
+}
@@ -0,0 +1,36 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Highlight transitions of all nodes, advanced together once per tick of the graph instead of by
+// a Blueprint timeline per node. The level scale of every transitioning node is eased from its
+// value at the start of the transition to AIGVNodeActor::LevelScaleAfterTransition, and the path
+// levels of its edges are blended in one pass over the edge store. An edge takes the progress of
+// the most recently started transition of its nodes, which set its levels before and after.
+class IMSVGRAPHVIS_API FIGVHighlightTransitionAnimator
+{
+	class AIGVGraphActor* const GraphActor;
+
+	// Active transitions in the order they started
+	TArray<class AIGVNodeActor*> Nodes;
+	TArray<float> ElapsedTimes;
+
+	// Edges of the active transitions and their progress, rebuilt every update
+	TArray<struct FIGVEdge*> Edges;
+	TArray<float> EdgeAlphas;
+	TMap<struct FIGVEdge*, int32> EdgeIdxs;
+
+public:
+	FIGVHighlightTransitionAnimator(class AIGVGraphActor* const InGraphActor);
+
+	void Begin(class AIGVNodeActor* const Node);  // Restarts a transition of the node
+	void Update(float const DeltaTime);
+	void Reset();  // Drops all transitions, before the nodes are destroyed
+
+	FORCEINLINE bool IsAnimating() const
+	{
+		return Nodes.Num() > 0;
+	}
+};
@@ -0,0 +1,76 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVInteractionState.h"
+
+FIGVInteractionState::FIGVInteractionState() : NumNodes(0), NumHighlightedNeighbors()
+{
+	ResetPickedNodes();
+}
+
+void FIGVInteractionState::Reset(int32 const InNumNodes)
+{
+	NumNodes = InNumNodes;
+
+	for (int32 Idx = 0; Idx < NumHands; Idx++)
+	{
+		DistanceToPickRay[Idx].Empty();
+		Highlighted[Idx].Empty();
+	}
+
+	NumHighlightedNeighbors.Init(0, NumNodes);
+
+	ResetPickedNodes();
+}
+
+void FIGVInteractionState::ResetPickedNodes()
+{
+	for (int32 Idx = 0; Idx < NumHands; Idx++)
+	{
+		LastNearestNodeIdx[Idx] = -1;
+		LastPickedNodeIdx[Idx] = -1;
+	}
+}
+
+float FIGVInteractionState::GetDistanceToPickRay(EControllerHand const Hand,
+												 int32 const NodeIdx) const
+{
+	TArray<float> const& Distances = DistanceToPickRay[HandIdx(Hand)];
+	return NodeIdx < Distances.Num() ? Distances[NodeIdx] : FLT_MAX;
+}
+
+void FIGVInteractionState::SetDistancesToPickRay(EControllerHand const Hand,
+												 float const* const Distances)
+{
+	TArray<float>& Dst = DistanceToPickRay[HandIdx(Hand)];
+	Dst.SetNumUninitialized(NumNodes, false);
+	FMemory::Memcpy(Dst.GetData(), Distances, sizeof(float) * NumNodes);
+}
+
+void FIGVInteractionState::ResetDistancesToPickRay()
+{
+	for (int32 Idx = 0; Idx < NumHands; Idx++)
+	{
+		DistanceToPickRay[Idx].Reset();
+	}
+}
+
+void FIGVInteractionState::SetHighlighted(EControllerHand const Hand, int32 const NodeIdx,
+										  bool const bValue)
+{
+	TBitArray<>& Bits = Highlighted[HandIdx(Hand)];
+	if (Bits.Num() != NumNodes)
+	{
+		Bits.Init(false, NumNodes);
+	}
+	Bits[NodeIdx] = bValue;
+}
+
+bool FIGVInteractionState::IsHighlightedByAnyHand(int32 const NodeIdx) const
+{
+	for (int32 Idx = 0; Idx < NumHands; Idx++)
+	{
+		TBitArray<> const& Bits = Highlighted[Idx];
+		if (NodeIdx < Bits.Num() && Bits[NodeIdx]) return true;
+	}
+	return false;
+}
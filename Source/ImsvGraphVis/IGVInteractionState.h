@@ -0,0 +1,52 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+
+// Per-hand interaction state of every node, stored as flat arrays and bit arrays indexed by
+// AIGVNodeActor::Idx. Hands that never cast a pick ray do not allocate any storage.
+struct IMSVGRAPHVIS_API FIGVInteractionState
+{
+	static int32 const NumHands = int32(EControllerHand::Special_11) + 1;
+
+	int32 NumNodes;
+
+	TArray<float> DistanceToPickRay[NumHands];
+	TBitArray<> Highlighted[NumHands];
+	TArray<int32> NumHighlightedNeighbors;
+
+	int32 LastNearestNodeIdx[NumHands];
+	int32 LastPickedNodeIdx[NumHands];
+
+public:
+	FIGVInteractionState();
+
+	void Reset(int32 const InNumNodes);
+	void ResetPickedNodes();
+
+	static FORCEINLINE int32 HandIdx(EControllerHand const Hand)
+	{
+		return int32(Hand);
+	}
+
+	float GetDistanceToPickRay(EControllerHand const Hand, int32 const NodeIdx) const;
+	void SetDistancesToPickRay(EControllerHand const Hand, float const* const Distances);
+	void ResetDistancesToPickRay();  // Every node is then out of reach of every hand
+
+	FORCEINLINE bool IsHighlighted(EControllerHand const Hand, int32 const NodeIdx) const
+	{
+		TBitArray<> const& Bits = Highlighted[HandIdx(Hand)];
+		return NodeIdx < Bits.Num() && Bits[NodeIdx];
+	}
+
+	void SetHighlighted(EControllerHand const Hand, int32 const NodeIdx, bool const bValue);
+
+	bool IsHighlightedByAnyHand(int32 const NodeIdx) const;
+
+	FORCEINLINE bool HasHighlightedNeighbor(int32 const NodeIdx) const
+	{
+		return NumHighlightedNeighbors[NodeIdx] > 0;
+	}
+};
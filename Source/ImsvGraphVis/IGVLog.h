@@ -2,6 +2,8 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogIGV, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("ImsvGraphVis"), STATGROUP_IGV, STATCAT_Advanced);
+
 #define IGV_LOG_S(LogVerbosity, FormatString, ...) \
 	KW_LOG_S(LogIGV, LogVerbosity, FormatString, ##__VA_ARGS__)
 
@@ -30,15 +30,13 @@ AIGVNodeActor::AIGVNodeActor()
 	: GraphActor(nullptr),
 	  Label("Unknown"),
 	  Pos2D(FVector2D::ZeroVector),
+	  NormalizedPos2D(FVector2D::ZeroVector),
 	  Pos3D(FVector::ZeroVector),
 	  LevelScale(1.f),
 	  LevelScaleBeforeTransition(1.f),
 	  LevelScaleAfterTransition(1.f),
 	  Color(FLinearColor::White),
 	  BaseColor(FLinearColor::White),
-	  DistanceToPickRay(FLT_MAX),
-	  bIsHighlighted(false),
-	  NumHighlightedNeighbors(0),
 	  MeshMaterialInstance(nullptr)
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -63,12 +61,6 @@ AIGVNodeActor::AIGVNodeActor()
 
 	GetNodeMaterial();
 	GetTranslucentNodeMaterial();
-
-	DistanceToPickRays.Add(EControllerHand::Left, FLT_MAX);  //DPK Added
-	DistanceToPickRays.Add(EControllerHand::Right, FLT_MAX); // DPK Added
-
-	bIsHighlightedMap.Add(EControllerHand::Left, false);  //DPK Added
-	bIsHighlightedMap.Add(EControllerHand::Right, false); // DPK Added
 }
 
 void AIGVNodeActor::Init(AIGVGraphActor* const InGraphActor)
@@ -107,9 +99,20 @@ FString AIGVNodeActor::ToString() const
 
 void AIGVNodeActor::SetPos3D()
 {
-	Pos3D = GraphActor->Project(Pos2D);
-	RootComponent->SetRelativeLocation(Pos3D * LevelScale * GraphActor->GetSphereRadius());
-	UpdateRotation();
+	SetPos3D(GraphActor->Project(Pos2D));
+}
+
+void AIGVNodeActor::SetPos3D(FVector const& InPos3D)
+{
+	Pos3D = InPos3D;
+	UpdateLocation();
+}
+
+void AIGVNodeActor::UpdateLocation()
+{
+	// One transform update for both
+	RootComponent->SetRelativeLocationAndRotation(Pos3D * LevelScale * GraphActor->GetSphereRadius(),
+												  (FVector::ZeroVector - Pos3D).Rotation());
 }
 
 void AIGVNodeActor::UpdateColor(FLinearColor const& C)
@@ -121,8 +124,11 @@ void AIGVNodeActor::UpdateColor(FLinearColor const& C)
 
 void AIGVNodeActor::SetColor(FLinearColor const& C)
 {
-	Color = C;
-	ShowColor(Color);
+	// Read by the splines
+	GraphActor->RunAfterEdgeMeshUpdate([this, C]() {
+		Color = C;
+		ShowColor(Color);
+	});
 }
 
 void AIGVNodeActor::ResetColor()
@@ -186,17 +192,52 @@ void AIGVNodeActor::UpdateRotation()
 
 bool AIGVNodeActor::IsPicked() const
 {
-	return DistanceToPickRay < GraphActor->PickDistanceThreshold;
+	return IsPicked(EControllerHand::Right);
 }
 
 bool AIGVNodeActor::IsNearPicked() const
 {
-	return DistanceToPickRay < GraphActor->SelectAllDistanceThreshold;
+	return IsNearPicked(EControllerHand::Right);
 }
 
 bool AIGVNodeActor::IsPicked(enum class EControllerHand Hand) const
 {
-	return DistanceToPickRays[Hand] < GraphActor->PickDistanceThreshold;
+	return GetDistanceToPickRay(Hand) < GraphActor->PickDistanceThreshold;
+}
+
+bool AIGVNodeActor::IsNearPicked(enum class EControllerHand Hand) const
+{
+	return GetDistanceToPickRay(Hand) < GraphActor->SelectAllDistanceThreshold;
+}
+
+float AIGVNodeActor::GetDistanceToPickRay(enum class EControllerHand Hand) const
+{
+	return GraphActor->Interaction.GetDistanceToPickRay(Hand, Idx);
+}
+
+bool AIGVNodeActor::IsHighlighted() const
+{
+	return IsHighlighted(EControllerHand::Right);
+}
+
+bool AIGVNodeActor::IsHighlighted(enum class EControllerHand Hand) const
+{
+	return GraphActor->Interaction.IsHighlighted(Hand, Idx);
+}
+
+void AIGVNodeActor::SetHighlightedState(enum class EControllerHand Hand, bool const bValue)
+{
+	// Read by the render groups
+	GraphActor->RunAfterEdgeMeshUpdate([this, Hand, bValue]() {
+		FIGVInteractionState& Interaction = GraphActor->Interaction;
+
+		// Picked nodes are the ones highlighted by the right hand
+		if (Hand == EControllerHand::Right && Interaction.IsHighlighted(Hand, Idx) != bValue)
+		{
+			GraphActor->Statistics.OnPickedChanged(bValue);
+		}
+		Interaction.SetHighlighted(Hand, Idx, bValue);
+	});
 }
 
 void AIGVNodeActor::BeginNearest()
@@ -235,15 +276,12 @@ void AIGVNodeActor::BeginPicked(enum class EControllerHand Hand, bool ShowImage)
 
 /*void AIGVNodeActor::EndPicked()
 {
-	if (!bIsHighlighted) TextRenderComponent->SetVisibility(false);
+	if (!IsHighlighted()) TextRenderComponent->SetVisibility(false);
 }*/
 
 void AIGVNodeActor::EndPicked(enum class EControllerHand Hand)
 {
-	TArray<bool> HighlightValues;
-	bIsHighlightedMap.GenerateValueArray(HighlightValues);
-
-	if (!HighlightValues.Contains(true)) {
+	if (!GraphActor->Interaction.IsHighlightedByAnyHand(Idx)) {
 		TextRenderComponent->SetVisibility(false);
 		ImageComponent->SetVisibility(false);
 	}
@@ -266,11 +304,10 @@ void AIGVNodeActor::EndPicked(enum class EControllerHand Hand)
 
 void AIGVNodeActor::BeginHighlighted(enum class EControllerHand Hand)
 {
-	bIsHighlightedMap[Hand] = true;
+	SetHighlightedState(Hand, true);
 	TextRenderComponent->SetVisibility(true);
 	if (Hand == EControllerHand::Right)
 	{
-		bIsHighlighted = true;
 		SetHalo(true);
 
 		LevelScaleAfterTransition = GraphActor->HighlightedLevelScale;
@@ -286,16 +323,13 @@ void AIGVNodeActor::BeginHighlighted(enum class EControllerHand Hand)
 	{
 		MeshMaterialInstance = UMaterialInstanceDynamic::Create(GetTranslucentNodeMaterial(), this);
 		if (MeshMaterialInstance) MeshComponent->SetMaterial(0, MeshMaterialInstance);
-		for (FIGVEdge* const Edge : Edges)
-		{
-			Edge->bUpdateMeshRequired = true;
-		}
+		MarkEdgesForMeshUpdate();
 	}
 }
 
 void AIGVNodeActor::BeginHighlighted()
 {
-	bIsHighlighted = true;
+	SetHighlightedState(EControllerHand::Right, true);
 	SetHalo(true);
 	TextRenderComponent->SetVisibility(true);
 
@@ -310,12 +344,11 @@ void AIGVNodeActor::BeginHighlighted()
 
 void AIGVNodeActor::EndHighlighted(enum class EControllerHand Hand)
 {
-	bIsHighlightedMap[Hand] = false;
+	SetHighlightedState(Hand, false);
 	TextRenderComponent->SetVisibility(false);
 
 	if (Hand == EControllerHand::Right)
 	{
-		bIsHighlighted = false;
 
 		if (HasHighlightedNeighbor())
 		{
@@ -344,16 +377,13 @@ void AIGVNodeActor::EndHighlighted(enum class EControllerHand Hand)
 			MeshComponent->SetMaterial(0, MeshMaterialInstance);
 			SetColor(Color);
 		}
-		for (FIGVEdge* const Edge : Edges)
-		{
-			Edge->bUpdateMeshRequired = true;
-		}
+		MarkEdgesForMeshUpdate();
 	}
 }
 
 void AIGVNodeActor::EndHighlighted()
 {
-	bIsHighlighted = false;
+	SetHighlightedState(EControllerHand::Right, false);
 	TextRenderComponent->SetVisibility(false);
 
 	if (HasHighlightedNeighbor())
@@ -377,9 +407,9 @@ void AIGVNodeActor::EndHighlighted()
 
 void AIGVNodeActor::BeginNeighborHighlighted()
 {
-	bool const TransionRequired = !(bIsHighlightedMap[EControllerHand::Right] || HasHighlightedNeighbor());
+	bool const TransionRequired = !(IsHighlighted() || HasHighlightedNeighbor());
 
-	NumHighlightedNeighbors++;
+	GraphActor->Interaction.NumHighlightedNeighbors[Idx]++;
 
 	if (TransionRequired)
 	{
@@ -391,10 +421,11 @@ void AIGVNodeActor::BeginNeighborHighlighted()
 
 void AIGVNodeActor::EndNeighborHighlighted()
 {
+	int32& NumHighlightedNeighbors = GraphActor->Interaction.NumHighlightedNeighbors[Idx];
 	NumHighlightedNeighbors--;
 	check(NumHighlightedNeighbors >= 0);
 
-	bool const TransionRequired = !(bIsHighlightedMap[EControllerHand::Right] || HasHighlightedNeighbor());
+	bool const TransionRequired = !(IsHighlighted() || HasHighlightedNeighbor());
 
 	if (TransionRequired)
 	{
@@ -406,26 +437,46 @@ void AIGVNodeActor::EndNeighborHighlighted()
 
 bool AIGVNodeActor::HasHighlightedNeighbor() const
 {
-	return NumHighlightedNeighbors > 0;
+	return GraphActor->Interaction.HasHighlightedNeighbor(Idx);
+}
+
+void AIGVNodeActor::MarkEdgesForMeshUpdate()
+{
+	GraphActor->RunAfterEdgeMeshUpdate([this]() {
+		for (FIGVEdge* const Edge : Edges)
+		{
+			Edge->bUpdateMeshRequired = true;
+		}
+	});
 }
 
 void AIGVNodeActor::BeginTransition()
 {
-	LevelScaleBeforeTransition = LevelScale;
+	// The levels are read by the splines
+	GraphActor->RunAfterEdgeMeshUpdate([this]() {
+		LevelScaleBeforeTransition = LevelScale;
 
-	for (FIGVEdge* const Edge : Edges)
-	{
-		Edge->BeginTransition();
-	}
+		for (FIGVEdge* const Edge : Edges)
+		{
+			GraphActor->Edges.BeginTransition(*Edge);
+		}
 
-	PlayFromStartHighlightTransitionTimeline();
+		if (GraphActor->bBatchedHighlightTransitions)
+		{
+			GraphActor->HighlightTransitionAnimator.Begin(this);
+		}
+		else
+		{
+			PlayFromStartHighlightTransitionTimeline();
+		}
+	});
 }
 
 /*void AIGVNodeActor::OnLeftMouseButtonReleased()
 {
 	check(IsPicked(EControllerHand::Right));
 
-	if (bIsHighlighted)
+	if (IsHighlighted())
 	{
 		EndHighlighted();
 	}
@@ -440,7 +491,7 @@ void AIGVNodeActor::OnRightTriggerButtonReleased()
 	auto Hand = EControllerHand::Right;
 	check(IsPicked(Hand));
 
-	if (bIsHighlightedMap[Hand])
+	if (IsHighlighted(Hand))
 	{
 		EndHighlighted(Hand);
 	}
@@ -455,7 +506,7 @@ void AIGVNodeActor::OnLeftTriggerButtonReleased()
 	auto Hand = EControllerHand::Left;
 	check(IsPicked(Hand));
 
-	if (bIsHighlightedMap[Hand])
+	if (IsHighlighted(Hand))
 	{
 		EndHighlighted(Hand);
 	}
@@ -495,19 +546,24 @@ void AIGVNodeActor::OnLeftGripPressed(FVector PickRayOrigin, FRotator PickRayRot
 void AIGVNodeActor::OnHighlightTransitionTimelineUpdate(ETimelineDirection::Type const Direction,
 														float const Alpha)
 {
-	LevelScale = FMath::Lerp(LevelScaleBeforeTransition, LevelScaleAfterTransition, Alpha);
-	SetPos3D();
+	// Timelines may tick after the graph, while its edge mesh update runs
+	GraphActor->RunAfterEdgeMeshUpdate([this, Direction, Alpha]() {
+		LevelScale = FMath::Lerp(LevelScaleBeforeTransition, LevelScaleAfterTransition, Alpha);
+		UpdateLocation();
 
-	for (FIGVEdge* const Edge : Edges)
-	{
-		Edge->OnHighlightTransitionTimelineUpdate(Direction, Alpha);
-	}
+		for (FIGVEdge* const Edge : Edges)
+		{
+			GraphActor->Edges.OnHighlightTransitionTimelineUpdate(*Edge, Direction, Alpha);
+		}
+	});
 }
 
 void AIGVNodeActor::OnHighlightTransitionTimelineFinished(ETimelineDirection::Type const Direction)
 {
-	for (FIGVEdge* const Edge : Edges)
-	{
-		Edge->OnHighlightTransitionTimelineFinished(Direction);
-	}
+	GraphActor->RunAfterEdgeMeshUpdate([this, Direction]() {
+		for (FIGVEdge* const Edge : Edges)
+		{
+			GraphActor->Edges.OnHighlightTransitionTimelineFinished(*Edge, Direction);
+		}
+	});
 }
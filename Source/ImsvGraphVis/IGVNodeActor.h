@@ -31,6 +31,9 @@ public:
 	UPROPERTY(BlueprintReadOnly, SaveGame, Category = ImmersiveGraphVisualization)
 	FVector2D Pos2D;
 
+	// Pos2D over AIGVGraphActor::PlanarExtent, in [-1, 1] after a treemap layout
+	FVector2D NormalizedPos2D;
+
 	UPROPERTY(BlueprintReadOnly, Category = ImmersiveGraphVisualization)
 	FVector Pos3D;
 
@@ -48,16 +51,9 @@ public:
 	UPROPERTY(BlueprintReadOnly, SaveGame, Category = ImmersiveGraphVisualization)
 	FLinearColor BaseColor;
 
-	float DistanceToPickRay;
-	TMap<enum class EControllerHand, float> DistanceToPickRays;
-
 	TArray<struct FIGVEdge*> Edges;
 	TArray<AIGVNodeActor*> Neighbors;
 
-	bool bIsHighlighted;
-	TMap<enum class EControllerHand, bool> bIsHighlightedMap;
-	int32 NumHighlightedNeighbors;
-
 	int32 Year;
 
 public:
@@ -87,6 +83,8 @@ public:
 	FString ToString() const;
 
 	void SetPos3D();
+	void SetPos3D(FVector const& InPos3D);  // Already projected
+	void UpdateLocation();					 // After Pos3D or LevelScale changed
 
 	void UpdateColor(FLinearColor const& C);
 	void SetColor(FLinearColor const& C);
@@ -103,6 +101,14 @@ public:
 	bool IsNearPicked() const;
 
 	bool IsPicked(enum class EControllerHand Hand) const;
+
+	bool IsNearPicked(enum class EControllerHand Hand) const;
+
+	// Per-hand state is kept in AIGVGraphActor::Interaction
+	float GetDistanceToPickRay(enum class EControllerHand Hand) const;
+
+	bool IsHighlighted() const;
+	bool IsHighlighted(enum class EControllerHand Hand) const;
 	
 	void BeginNearest();
 	void EndNearest();
@@ -125,6 +131,9 @@ public:
 
 	bool HasHighlightedNeighbor() const;
 
+	// Node state read by the edge mesh update is changed through
+	// AIGVGraphActor::RunAfterEdgeMeshUpdate, so these may take effect at the next tick
+	void MarkEdgesForMeshUpdate();
 	void BeginTransition();
 
 	//void OnLeftMouseButtonReleased();
@@ -147,4 +156,8 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 	void OnHighlightTransitionTimelineFinished(ETimelineDirection::Type const Direction);
+
+protected:
+	// Updates AIGVGraphActor::Interaction and the picked count in AIGVGraphActor::Statistics
+	void SetHighlightedState(enum class EControllerHand Hand, bool const bValue);
 };
@@ -11,6 +11,7 @@
 // VR
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
+#include "IGVPickRay.h"
 
 AIGVPawn::AIGVPawn() : CursorDistanceScale(0.7)
 {
@@ -236,6 +237,15 @@ void AIGVPawn::DrawLaser(UMotionControllerComponent* HandComponent)
 	}*/
 }
 
+void AIGVPawn::GetPickRays(TArray<FIGVPickRay>& OutRays) const
+{
+	OutRays.Reset();
+	for (auto const& Entry : PickRayInformation)
+	{
+		OutRays.Emplace(Entry.Key, Entry.Value.Key, Entry.Value.Value);
+	}
+}
+
 void AIGVPawn::OnLeftXCapTouch(float Value)
 {
 	IGV_LOG(Log, TEXT("LeftXCapTouch. Value: %f"), Value);
@@ -473,16 +483,14 @@ void AIGVPawn::UpdateGraphDetailsWidget()
 	FString FOVString = FString::FromInt(FOV);
 	FOVString += FString("deg");
 
-	auto HighlightedLevelScale = GraphActor->HighlightedLevelScale;
-	int32 PickedCount = 0;
-	for (AIGVNodeActor* const Node : GraphActor->Nodes)
-	{
-		if (Node->LevelScale == HighlightedLevelScale) PickedCount += 1;
-	}
-
-	FString PickedCountString = FString::FromInt(PickedCount);
+	FIGVGraphStatistics const& Statistics = GraphActor->Statistics;
 
-	GraphDetailsUserWidget->NumPicked = PickedCountString;
+	GraphDetailsUserWidget->NumEdges = FString::FromInt(GraphActor->Edges.Num());
+	GraphDetailsUserWidget->NumPicked = FString::FromInt(Statistics.GetNumPicked());
+	GraphDetailsUserWidget->NumComponents = FString::FromInt(Statistics.GetNumComponents());
+	GraphDetailsUserWidget->NumClusters = FString::FromInt(Statistics.GetNumClusters());
+	GraphDetailsUserWidget->Modularity = FString::SanitizeFloat(Statistics.GetModularity());
+	GraphDetailsUserWidget->MaxDegree = FString::FromInt(Statistics.GetMaxDegree());
 	GraphDetailsUserWidget->FOV = FOVString;
 	GraphDetailsUserWidget->AspectRatio = AspectRatio;
 }
@@ -126,4 +126,8 @@ public:
 	bool bRightGripHeld;
 
 	TMap<enum class EControllerHand, TPair<FVector, FRotator> > PickRayInformation;
+
+	// One pick ray per entry of PickRayInformation. Additional input sources (gaze, spectator
+	// cursors) only need an entry there to take part in picking.
+	void GetPickRays(TArray<struct FIGVPickRay>& OutRays) const;
 };
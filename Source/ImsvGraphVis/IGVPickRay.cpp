@@ -0,0 +1,166 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#include "IGVPickRay.h"
+
+#include "IGVNodeActor.h"
+
+FIGVPickRay::FIGVPickRay(EControllerHand const InHand, FVector const& InOrigin,
+						 FRotator const& InRotation)
+	: Hand(InHand), Origin(InOrigin), Direction(InRotation.Vector().GetSafeNormal())
+{
+}
+
+FIGVPickRay::FIGVPickRay(EControllerHand const InHand, FVector const& InOrigin,
+						 FVector const& InDirection)
+	: Hand(InHand), Origin(InOrigin), Direction(InDirection.GetSafeNormal())
+{
+}
+
+FIGVPickRayHit::FIGVPickRayHit()
+	: Hand(EControllerHand::Right),
+	  NearestNodeIdx(-1),
+	  NearestDistance(FLT_MAX),
+	  PickedNodeIdxs(),
+	  NearPickedNodeIdxs()
+{
+}
+
+void FIGVPickRayHit::Reset(EControllerHand const InHand)
+{
+	Hand = InHand;
+	NearestNodeIdx = -1;
+	NearestDistance = FLT_MAX;
+	PickedNodeIdxs.Reset();
+	NearPickedNodeIdxs.Reset();
+}
+
+FIGVPickRayQuery::FIGVPickRayQuery() : NumNodes(0), PosX(), PosY(), PosZ(), Distances()
+{
+}
+
+void FIGVPickRayQuery::Empty()
+{
+	NumNodes = 0;
+	PosX.Empty();
+	PosY.Empty();
+	PosZ.Empty();
+	Distances.Empty();
+}
+
+int32 FIGVPickRayQuery::NumPaddedNodes() const
+{
+	return Align(NumNodes, 4);
+}
+
+void FIGVPickRayQuery::SetNodePositions(TArray<AIGVNodeActor*> const& Nodes)
+{
+	NumNodes = Nodes.Num();
+	int32 const NumPadded = NumPaddedNodes();
+
+	PosX.SetNumUninitialized(NumPadded, false);
+	PosY.SetNumUninitialized(NumPadded, false);
+	PosZ.SetNumUninitialized(NumPadded, false);
+
+	for (int32 Idx = 0; Idx < NumNodes; Idx++)
+	{
+		FVector const P = Nodes[Idx]->GetActorLocation();
+		PosX[Idx] = P.X;
+		PosY[Idx] = P.Y;
+		PosZ[Idx] = P.Z;
+	}
+
+	// Padding lanes are placed far away so that they never become the nearest node
+	for (int32 Idx = NumNodes; Idx < NumPadded; Idx++)
+	{
+		PosX[Idx] = PosY[Idx] = PosZ[Idx] = HALF_WORLD_MAX;
+	}
+}
+
+void FIGVPickRayQuery::Query(TArray<FIGVPickRay> const& Rays, float const PickDistanceThreshold,
+							 float const NearPickDistanceThreshold,
+							 TArray<FIGVPickRayHit>& OutHits)
+{
+	int32 const NumRays = Rays.Num();
+	int32 const NumPadded = NumPaddedNodes();
+
+	OutHits.SetNum(NumRays);
+	for (int32 RayIdx = 0; RayIdx < NumRays; RayIdx++)
+	{
+		OutHits[RayIdx].Reset(Rays[RayIdx].Hand);
+	}
+
+	Distances.SetNumUninitialized(NumRays * NumPadded, false);
+
+	if (NumRays == 0 || NumNodes == 0) return;
+
+	float const PickDistanceSquared = FMath::Square(PickDistanceThreshold);
+	float const NearPickDistanceSquared = FMath::Square(NearPickDistanceThreshold);
+
+	// Distance from P to the line through O along the unit vector D is |V|^2 - (V.D)^2 where
+	// V = P - O, which only needs multiply-adds.
+	for (int32 BlockIdx = 0; BlockIdx < NumPadded; BlockIdx += 4)
+	{
+		VectorRegister const PX = VectorLoadAligned(&PosX[BlockIdx]);
+		VectorRegister const PY = VectorLoadAligned(&PosY[BlockIdx]);
+		VectorRegister const PZ = VectorLoadAligned(&PosZ[BlockIdx]);
+
+		for (int32 RayIdx = 0; RayIdx < NumRays; RayIdx++)
+		{
+			FIGVPickRay const& Ray = Rays[RayIdx];
+
+			VectorRegister const VX = VectorSubtract(PX, VectorSetFloat1(Ray.Origin.X));
+			VectorRegister const VY = VectorSubtract(PY, VectorSetFloat1(Ray.Origin.Y));
+			VectorRegister const VZ = VectorSubtract(PZ, VectorSetFloat1(Ray.Origin.Z));
+
+			VectorRegister const T = VectorMultiplyAdd(
+				VX, VectorSetFloat1(Ray.Direction.X),
+				VectorMultiplyAdd(VY, VectorSetFloat1(Ray.Direction.Y),
+								  VectorMultiply(VZ, VectorSetFloat1(Ray.Direction.Z))));
+			VectorRegister const VV =
+				VectorMultiplyAdd(VX, VX, VectorMultiplyAdd(VY, VY, VectorMultiply(VZ, VZ)));
+			VectorRegister const DistanceSquared =
+				VectorMax(VectorSubtract(VV, VectorMultiply(T, T)), VectorZero());
+
+			float* const Out = &Distances[RayIdx * NumPadded + BlockIdx];
+			VectorStoreAligned(DistanceSquared, Out);
+
+			FIGVPickRayHit& Hit = OutHits[RayIdx];
+			for (int32 Lane = 0, NumLanes = FMath::Min(4, NumNodes - BlockIdx); Lane < NumLanes;
+				 Lane++)
+			{
+				float const D2 = Out[Lane];
+				int32 const NodeIdx = BlockIdx + Lane;
+
+				if (D2 < Hit.NearestDistance)
+				{
+					Hit.NearestDistance = D2;
+					Hit.NearestNodeIdx = NodeIdx;
+				}
+
+				if (D2 < NearPickDistanceSquared)
+				{
+					Hit.NearPickedNodeIdxs.Add(NodeIdx);
+					if (D2 < PickDistanceSquared)
+					{
+						Hit.PickedNodeIdxs.Add(NodeIdx);
+					}
+				}
+
+				Out[Lane] = FMath::Sqrt(D2);
+			}
+		}
+	}
+
+	for (FIGVPickRayHit& Hit : OutHits)
+	{
+		if (Hit.NearestNodeIdx != -1)
+		{
+			Hit.NearestDistance = FMath::Sqrt(Hit.NearestDistance);
+		}
+	}
+}
+
+float FIGVPickRayQuery::GetDistance(int32 const RayIdx, int32 const NodeIdx) const
+{
+	return Distances[RayIdx * NumPaddedNodes() + NodeIdx];
+}
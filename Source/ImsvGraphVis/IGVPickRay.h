@@ -0,0 +1,66 @@
+// Copyright 2018 David Kuhta. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+
+// A pick ray cast by an input source. Motion controllers use EControllerHand::Left/Right; gaze
+// and spectator cursors can use any of the remaining EControllerHand values (e.g. Special_1).
+struct IMSVGRAPHVIS_API FIGVPickRay
+{
+	EControllerHand Hand;
+	FVector Origin;
+	FVector Direction;  // Normalized
+
+	FIGVPickRay() = default;
+	FIGVPickRay(EControllerHand const InHand, FVector const& InOrigin, FRotator const& InRotation);
+	FIGVPickRay(EControllerHand const InHand, FVector const& InOrigin, FVector const& InDirection);
+};
+
+struct IMSVGRAPHVIS_API FIGVPickRayHit
+{
+	EControllerHand Hand;
+
+	int32 NearestNodeIdx;  // -1 if there is no node
+	float NearestDistance;
+
+	TArray<int32> PickedNodeIdxs;	  // Distance < PickDistanceThreshold
+	TArray<int32> NearPickedNodeIdxs;  // Distance < SelectAllDistanceThreshold
+
+	FIGVPickRayHit();
+
+	void Reset(EControllerHand const InHand);
+};
+
+// Batched point-to-ray distance queries over all node positions. Node positions are kept as
+// padded structure-of-arrays so that every ray is tested against four nodes per SIMD operation,
+// and every node block is loaded once for all rays.
+class IMSVGRAPHVIS_API FIGVPickRayQuery
+{
+public:
+	typedef TArray<float, TAlignedHeapAllocator<16>> FAlignedFloatArray;
+
+	int32 NumNodes;
+
+	FAlignedFloatArray PosX;
+	FAlignedFloatArray PosY;
+	FAlignedFloatArray PosZ;
+
+	// Distances[RayIdx * NumPaddedNodes() + NodeIdx]
+	FAlignedFloatArray Distances;
+
+public:
+	FIGVPickRayQuery();
+
+	void Empty();
+
+	int32 NumPaddedNodes() const;
+
+	void SetNodePositions(TArray<class AIGVNodeActor*> const& Nodes);
+
+	void Query(TArray<FIGVPickRay> const& Rays, float const PickDistanceThreshold,
+			   float const NearPickDistanceThreshold, TArray<FIGVPickRayHit>& OutHits);
+
+	float GetDistance(int32 const RayIdx, int32 const NodeIdx) const;
+};
@@ -56,7 +56,7 @@ void AIGVPlayerController::IGV_SetFieldOfView(float Value)
 	}
 
 	GraphActor->FieldOfView = Value;
-	GraphActor->UpdateTreemapLayout();
+	GraphActor->UpdateViewExtent();
 }
 
 void AIGVPlayerController::IGV_SetAspectRatio(float Value)
@@ -81,7 +81,7 @@ void AIGVPlayerController::IGV_SetAspectRatio(float Value)
 	}
 
 	GraphActor->AspectRatio = Value;
-	GraphActor->UpdateTreemapLayout();
+	GraphActor->UpdateViewExtent();
 }
 
 void AIGVPlayerController::IGV_SetTreemapNesting(float Value)
@@ -1,3 +1,236 @@
 // Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
 
 #include "IGVProjection.h"
+
+// Four points at a time, from the planar coordinates X and Y to the sphere coordinates Out*
+template <EIGVProjection Mode>
+struct TIGVSphereProjection;
+
+template <>
+struct TIGVSphereProjection<EIGVProjection::Sphere_SphericalCoordinates>
+{
+	// Polar angle PI / 2 - Y, clamped to [0, PI], and azimuth X
+	static FORCEINLINE void Project(VectorRegister const X, VectorRegister Y, VectorRegister& OutX,
+									VectorRegister& OutY, VectorRegister& OutZ)
+	{
+		VectorRegister const HalfPi = VectorSetFloat1(HALF_PI);
+		Y = VectorMax(VectorMin(Y, HalfPi), VectorNegate(HalfPi));
+
+		VectorRegister SinX, CosX, SinY, CosY;
+		VectorSinCos(&SinX, &CosX, &X);
+		VectorSinCos(&SinY, &CosY, &Y);
+
+		OutX = VectorMultiply(CosY, CosX);
+		OutY = VectorMultiply(CosY, SinX);
+		OutZ = SinY;
+	}
+};
+
+template <>
+struct TIGVSphereProjection<EIGVProjection::Sphere_Gnomonic>
+{
+	static FORCEINLINE void Project(VectorRegister const X, VectorRegister const Y,
+									VectorRegister& OutX, VectorRegister& OutY,
+									VectorRegister& OutZ)
+	{
+		VectorRegister const One = GlobalVectorConstants::FloatOne;
+		VectorRegister const InvLength = VectorReciprocalSqrtAccurate(
+			VectorMultiplyAdd(X, X, VectorMultiplyAdd(Y, Y, One)));
+
+		OutX = InvLength;
+		OutY = VectorMultiply(X, InvLength);
+		OutZ = VectorMultiply(Y, InvLength);
+	}
+};
+
+// (Cos S, Sin S * P / S) for the distance S of P from the center. This is the gnomonic projection
+// of P / S * Tan S, and the stereographic one of P / S * 2 * Tan(S / 2).
+struct FIGVSphereRadialWarping
+{
+	static FORCEINLINE void Project(VectorRegister const X, VectorRegister const Y,
+									VectorRegister& OutX, VectorRegister& OutY,
+									VectorRegister& OutZ)
+	{
+		VectorRegister const SizeSquared = VectorMultiplyAdd(X, X, VectorMultiply(Y, Y));
+		VectorRegister const Mask =
+			VectorCompareGT(SizeSquared, VectorSetFloat1(SMALL_NUMBER * SMALL_NUMBER));
+		VectorRegister const InvSize = VectorSelect(
+			Mask, VectorReciprocalSqrtAccurate(SizeSquared), GlobalVectorConstants::FloatZero);
+		VectorRegister const Size = VectorMultiply(SizeSquared, InvSize);
+
+		VectorRegister SinSize, CosSize;
+		VectorSinCos(&SinSize, &CosSize, &Size);
+		VectorRegister const Scale = VectorMultiply(SinSize, InvSize);
+
+		OutX = CosSize;
+		OutY = VectorMultiply(X, Scale);
+		OutZ = VectorMultiply(Y, Scale);
+	}
+};
+
+template <>
+struct TIGVSphereProjection<EIGVProjection::Sphere_Gnomonic_RadialWarping>
+	: FIGVSphereRadialWarping
+{
+};
+
+template <>
+struct TIGVSphereProjection<EIGVProjection::Sphere_Gnomonic_IndependentWarping>
+{
+	static FORCEINLINE void Project(VectorRegister const X, VectorRegister const Y,
+									VectorRegister& OutX, VectorRegister& OutY,
+									VectorRegister& OutZ)
+	{
+		VectorRegister SinX, CosX, SinY, CosY;
+		VectorSinCos(&SinX, &CosX, &X);
+		VectorSinCos(&SinY, &CosY, &Y);
+		VectorRegister const TanX = VectorMultiply(SinX, VectorReciprocalAccurate(CosX));
+		VectorRegister const TanY = VectorMultiply(SinY, VectorReciprocalAccurate(CosY));
+
+		TIGVSphereProjection<EIGVProjection::Sphere_Gnomonic>::Project(TanX, TanY, OutX, OutY,
+																		OutZ);
+	}
+};
+
+// Inverse stereographic projection of Q from the point opposite to the view direction:
+// (1 - |Q|^2, 2 * Q) / (1 + |Q|^2), for half of the planar coordinates Q
+struct FIGVSphereStereographic
+{
+	static FORCEINLINE void ProjectHalf(VectorRegister const HalfX, VectorRegister const HalfY,
+										VectorRegister& OutX, VectorRegister& OutY,
+										VectorRegister& OutZ)
+	{
+		VectorRegister const One = GlobalVectorConstants::FloatOne;
+		VectorRegister const SizeSquared =
+			VectorMultiplyAdd(HalfX, HalfX, VectorMultiply(HalfY, HalfY));
+		VectorRegister const InvDenominator = VectorReciprocalAccurate(VectorAdd(One, SizeSquared));
+		VectorRegister const Scale = VectorAdd(InvDenominator, InvDenominator);
+
+		OutX = VectorMultiply(VectorSubtract(One, SizeSquared), InvDenominator);
+		OutY = VectorMultiply(HalfX, Scale);
+		OutZ = VectorMultiply(HalfY, Scale);
+	}
+};
+
+template <>
+struct TIGVSphereProjection<EIGVProjection::Sphere_Stereographic>
+{
+	static FORCEINLINE void Project(VectorRegister const X, VectorRegister const Y,
+									VectorRegister& OutX, VectorRegister& OutY,
+									VectorRegister& OutZ)
+	{
+		VectorRegister const Half = VectorSetFloat1(0.5f);
+		FIGVSphereStereographic::ProjectHalf(VectorMultiply(X, Half), VectorMultiply(Y, Half),
+											 OutX, OutY, OutZ);
+	}
+};
+
+template <>
+struct TIGVSphereProjection<EIGVProjection::Sphere_Stereographic_RadialWarping>
+	: FIGVSphereRadialWarping
+{
+};
+
+template <>
+struct TIGVSphereProjection<EIGVProjection::Sphere_Stereographic_IndependentWarping>
+{
+	static FORCEINLINE void Project(VectorRegister const X, VectorRegister const Y,
+									VectorRegister& OutX, VectorRegister& OutY,
+									VectorRegister& OutZ)
+	{
+		VectorRegister const Half = VectorSetFloat1(0.5f);
+		VectorRegister const HalfX = VectorMultiply(X, Half);
+		VectorRegister const HalfY = VectorMultiply(Y, Half);
+
+		VectorRegister SinX, CosX, SinY, CosY;
+		VectorSinCos(&SinX, &CosX, &HalfX);
+		VectorSinCos(&SinY, &CosY, &HalfY);
+		FIGVSphereStereographic::ProjectHalf(VectorMultiply(SinX, VectorReciprocalAccurate(CosX)),
+											 VectorMultiply(SinY, VectorReciprocalAccurate(CosY)),
+											 OutX, OutY, OutZ);
+	}
+};
+
+template <EIGVProjection Mode>
+static void ProjectToSphereImpl(float const* const X, float const* const Y, int32 const Num,
+							FVector* const OutPoints)
+{
+	MS_ALIGN(16) float InX[4] GCC_ALIGN(16);
+	MS_ALIGN(16) float InY[4] GCC_ALIGN(16);
+	MS_ALIGN(16) float Out[3][4] GCC_ALIGN(16);
+
+	for (int32 BeginIdx = 0; BeginIdx < Num; BeginIdx += 4)
+	{
+		int32 const NumPoints = FMath::Min(Num - BeginIdx, 4);
+
+		// The last points are padded with the center
+		VectorRegister PX, PY;
+		if (NumPoints == 4)
+		{
+			PX = VectorLoad(X + BeginIdx);
+			PY = VectorLoad(Y + BeginIdx);
+		}
+		else
+		{
+			FMemory::Memzero(InX);
+			FMemory::Memzero(InY);
+			FMemory::Memcpy(InX, X + BeginIdx, sizeof(float) * NumPoints);
+			FMemory::Memcpy(InY, Y + BeginIdx, sizeof(float) * NumPoints);
+			PX = VectorLoadAligned(InX);
+			PY = VectorLoadAligned(InY);
+		}
+
+		VectorRegister OutX, OutY, OutZ;
+		TIGVSphereProjection<Mode>::Project(PX, PY, OutX, OutY, OutZ);
+		VectorStoreAligned(OutX, Out[0]);
+		VectorStoreAligned(OutY, Out[1]);
+		VectorStoreAligned(OutZ, Out[2]);
+
+		for (int32 Idx = 0; Idx < NumPoints; Idx++)
+		{
+			OutPoints[BeginIdx + Idx] = FVector(Out[0][Idx], Out[1][Idx], Out[2][Idx]);
+		}
+	}
+}
+
+void ProjectToSphere(EIGVProjection const Mode, TArrayView<float const> const X,
+					 TArrayView<float const> const Y, TArrayView<FVector> const OutPoints)
+{
+	check(X.Num() == Y.Num() && X.Num() == OutPoints.Num());
+
+	float const* const XData = X.GetData();
+	float const* const YData = Y.GetData();
+	int32 const Num = X.Num();
+	FVector* const OutData = OutPoints.GetData();
+
+	switch (Mode)
+	{
+		case EIGVProjection::Sphere_SphericalCoordinates:
+			ProjectToSphereImpl<EIGVProjection::Sphere_SphericalCoordinates>(XData, YData, Num,
+																			 OutData);
+			break;
+		case EIGVProjection::Sphere_Gnomonic:
+			ProjectToSphereImpl<EIGVProjection::Sphere_Gnomonic>(XData, YData, Num, OutData);
+			break;
+		case EIGVProjection::Sphere_Gnomonic_RadialWarping:
+			ProjectToSphereImpl<EIGVProjection::Sphere_Gnomonic_RadialWarping>(XData, YData, Num,
+																			   OutData);
+			break;
+		case EIGVProjection::Sphere_Gnomonic_IndependentWarping:
+			ProjectToSphereImpl<EIGVProjection::Sphere_Gnomonic_IndependentWarping>(
+				XData, YData, Num, OutData);
+			break;
+		case EIGVProjection::Sphere_Stereographic:
+			ProjectToSphereImpl<EIGVProjection::Sphere_Stereographic>(XData, YData, Num, OutData);
+			break;
+		case EIGVProjection::Sphere_Stereographic_RadialWarping:
+			ProjectToSphereImpl<EIGVProjection::Sphere_Stereographic_RadialWarping>(
+				XData, YData, Num, OutData);
+			break;
+		case EIGVProjection::Sphere_Stereographic_IndependentWarping:
+			ProjectToSphereImpl<EIGVProjection::Sphere_Stereographic_IndependentWarping>(
+				XData, YData, Num, OutData);
+			break;
+		default: checkNoEntry(); break;
+	}
+}
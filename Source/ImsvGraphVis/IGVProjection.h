@@ -92,3 +92,11 @@ public:
 		return FVector(-V.Z, V.X, V.Y);
 	}
 };
+
+// Projects the planar points (X[Idx], Y[Idx]) onto the unit sphere like UIGVProjection, four at a
+// time with vector math. The projection is chosen once per call rather than per point, and the
+// trigonometric functions are either rewritten into algebraic ones or evaluated with the minimax
+// polynomials of VectorSinCos, whose error is around single precision round-off.
+IMSVGRAPHVIS_API void ProjectToSphere(EIGVProjection const Mode, TArrayView<float const> const X,
+									  TArrayView<float const> const Y,
+									  TArrayView<FVector> const OutPoints);
@@ -5,9 +5,10 @@
 
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
+#include "KWTask.h"
 
 FIGVTreemapNode::FIGVTreemapNode(FIGVCluster* const InCluster)
-	: Cluster(InCluster), Children(), Rect(), Weight(1.f)
+	: Cluster(InCluster), Children(), Rect(), Weight(1.f), RandomStream(), ChildWeightSums()
 {
 }
 
@@ -16,21 +17,24 @@ bool FIGVTreemapNode::IsLeaf() const
 	return Children.Num() == 0;
 }
 
-void FIGVTreemapNode::SetRandomWeights()
+void FIGVTreemapNode::SetRandomWeight()
 {
-	ForEachDescendantFirst([](FIGVTreemapNode& Node) {
-		if (Node.IsLeaf())
-		{
-			Node.Weight = FMath::FRandRange(1.f, 2.f);
-		}
-		else
+	if (IsLeaf())
+	{
+		Weight = RandomStream.FRandRange(1.f, 2.f);
+	}
+	else
+	{
+		for (FIGVTreemapNode* const Child : Children)
 		{
-			for (FIGVTreemapNode* const Child : Node.Children)
-			{
-				Node.Weight += Child->Weight;
-			}
+			Weight += Child->Weight;
 		}
-	});
+	}
+}
+
+void FIGVTreemapNode::SetRandomWeights()
+{
+	ForEachDescendantFirst([](FIGVTreemapNode& Node) { Node.SetRandomWeight(); });
 }
 
 void FIGVTreemapNode::SortChildrenBySize()
@@ -39,6 +43,16 @@ void FIGVTreemapNode::SortChildrenBySize()
 		[](FIGVTreemapNode const& A, FIGVTreemapNode const& B) { return A.Weight > B.Weight; });
 }
 
+void FIGVTreemapNode::UpdateChildWeightSums()
+{
+	ChildWeightSums.SetNumUninitialized(Children.Num() + 1);
+	ChildWeightSums[0] = 0;
+	for (int32 Idx = 0; Idx < Children.Num(); Idx++)
+	{
+		ChildWeightSums[Idx + 1] = ChildWeightSums[Idx] + Children[Idx]->Weight;
+	}
+}
+
 FIGVTreemapLayout::FIGVTreemapLayout(AIGVGraphActor* const InGraphActor)
 	: GraphActor(InGraphActor),
 	  RootCluster(GraphActor->RootCluster),
@@ -51,26 +65,117 @@ void FIGVTreemapLayout::Compute()
 {
 	SetupTreemapNodes();
 
-	RootTreemapNode->SetRandomWeights();
 	RootTreemapNode->Rect = FBox2D(-GraphActor->PlanarExtent, GraphActor->PlanarExtent);
+	ComputeRects();
+}
+
+void FIGVTreemapLayout::ComputeSubtree(FIGVCluster& SubtreeRoot)
+{
+	SetupTreemapNodes(SubtreeRoot);
+
+	RootTreemapNode->Rect = SubtreeRoot.TreemapRect;
+	ComputeRects();
+}
+
+void FIGVTreemapLayout::ComputeRects()
+{
+	int32 const Seed = GraphActor->TreemapRandomSeed;
+	for (FIGVTreemapNode& TreemapNode : TreemapNodes)
+	{
+		TreemapNode.RandomStream.Initialize(
+			HashCombine(GetTypeHash(Seed), GetTypeHash(TreemapNode.Cluster->Idx)));
+	}
 
 	float const Nesting = GraphActor->TreemapNesting;
-	RootTreemapNode->ForEachAncestorFirst([Nesting](FIGVTreemapNode& Node) {
-		if (!Node.IsLeaf())
+	if (GraphActor->bParallelTreemapLayout)
+	{
+		ComputeRectsParallel(Nesting);
+	}
+	else
+	{
+		RootTreemapNode->SetRandomWeights();
+
+		RootTreemapNode->ForEachAncestorFirst([Nesting](FIGVTreemapNode& Node) {
+			if (!Node.IsLeaf())
+			{
+				Squarified(Node, Nesting);
+			}
+		});
+	}
+
+	// A single chunk runs on this thread
+	int32 const MinChunkSize = GraphActor->bParallelTreemapLayout ? 256 : TreemapNodes.Num();
+	KWParallelFor(TreemapNodes.Num(), [this](int32 const Begin, int32 const End) {
+		for (int32 Idx = Begin; Idx < End; Idx++)
+		{
+			FIGVTreemapNode& TreemapNode = TreemapNodes[Idx];
+			TreemapNode.Cluster->TreemapRect = TreemapNode.Rect;
+
+			FVector2D Center, Extents;
+			TreemapNode.Rect.GetCenterAndExtents(Center, Extents);
+			Center.Y *= -1;
+			float const OffsetX = TreemapNode.RandomStream.FRandRange(-Extents.X, Extents.X);
+			float const OffsetY = TreemapNode.RandomStream.FRandRange(-Extents.Y, Extents.Y);
+			TreemapNode.Cluster->SetPos2D(Center + 0.5 * FVector2D(OffsetX, OffsetY));
+		}
+	}, MinChunkSize);
+}
+
+void FIGVTreemapLayout::ComputeRectsParallel(float const Nesting)
+{
+	// Moves the frontier down a level at a time until there are enough subtrees to balance
+	TArray<FIGVTreemapNode*> TopNodes;  // Breadth first
+	TArray<FIGVTreemapNode*> Subtrees;
+	Subtrees.Add(RootTreemapNode);
+
+	int32 const MinNumSubtrees = 8 * (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+	while (Subtrees.Num() < MinNumSubtrees)
+	{
+		TArray<FIGVTreemapNode*> NextSubtrees;
+		for (FIGVTreemapNode* const Node : Subtrees)
+		{
+			NextSubtrees.Append(Node->Children);
+		}
+		if (NextSubtrees.Num() == 0)
+		{
+			break;
+		}
+
+		TopNodes.Append(Subtrees);
+		Subtrees = MoveTemp(NextSubtrees);
+	}
+
+	// Weights bottom up: the subtrees, then the nodes above them in reverse breadth first order
+	KWParallelFor(Subtrees.Num(), [&Subtrees](int32 const Begin, int32 const End) {
+		for (int32 Idx = Begin; Idx < End; Idx++)
 		{
-			Squarified(Node, Nesting);
+			Subtrees[Idx]->SetRandomWeights();
 		}
 	});
+	for (int32 Idx = TopNodes.Num() - 1; Idx >= 0; Idx--)
+	{
+		TopNodes[Idx]->SetRandomWeight();
+	}
 
-	for (FIGVTreemapNode& TreemapNode : TreemapNodes)
+	// Rects top down, which gives every subtree root its rect before the subtrees are laid out
+	for (FIGVTreemapNode* const Node : TopNodes)
 	{
-		FVector2D Center, Extents;
-		TreemapNode.Rect.GetCenterAndExtents(Center, Extents);
-		Center.Y *= -1;
-		FVector2D const Offset = 0.5 * FVector2D(FMath::FRandRange(-Extents.X, Extents.X),
-												 FMath::FRandRange(-Extents.Y, Extents.Y));
-		TreemapNode.Cluster->SetPos2D(Center + Offset);
+		if (!Node->IsLeaf())
+		{
+			Squarified(*Node, Nesting);
+		}
 	}
+	KWParallelFor(Subtrees.Num(), [&Subtrees, Nesting](int32 const Begin, int32 const End) {
+		for (int32 Idx = Begin; Idx < End; Idx++)
+		{
+			Subtrees[Idx]->ForEachAncestorFirst([Nesting](FIGVTreemapNode& Node) {
+				if (!Node.IsLeaf())
+				{
+					Squarified(Node, Nesting);
+				}
+			});
+		}
+	});
 }
 
 void FIGVTreemapLayout::SetupTreemapNodes()
@@ -91,6 +196,30 @@ void FIGVTreemapLayout::SetupTreemapNodes()
 	RootTreemapNode = &TreemapNodes.Last();
 }
 
+void FIGVTreemapLayout::SetupTreemapNodes(FIGVCluster& SubtreeRoot)
+{
+	TArray<FIGVCluster*> SubtreeClusters;
+	SubtreeRoot.ForEachAncestorFirst([&](FIGVCluster& Cluster) { SubtreeClusters.Add(&Cluster); });
+
+	TMap<FIGVCluster const*, int32> TreemapNodeIdxs;
+	TreemapNodes.Reserve(SubtreeClusters.Num());
+	for (FIGVCluster* const Cluster : SubtreeClusters)
+	{
+		TreemapNodeIdxs.Add(Cluster, TreemapNodes.Emplace(Cluster));
+	}
+
+	for (FIGVCluster* const Cluster : SubtreeClusters)
+	{
+		if (Cluster != &SubtreeRoot)
+		{
+			TreemapNodes[TreemapNodeIdxs[Cluster->Parent]].Children.Add(
+				&TreemapNodes[TreemapNodeIdxs[Cluster]]);
+		}
+	}
+
+	RootTreemapNode = &TreemapNodes[0];
+}
+
 void FIGVTreemapLayout::SliceAndDice(FIGVTreemapNode& ParentNode, int32 const FirstIdx,
 									 int32 const LastIdx, FBox2D const& Bounds,
 									 EIGVTreemapOrientation const Orientation)
@@ -152,59 +281,70 @@ void FIGVTreemapLayout::SliceAndDice(FIGVTreemapNode& ParentNode, int32 const Fi
 void FIGVTreemapLayout::SliceAndDice(FIGVTreemapNode& ParentNode, const FBox2D& Bounds,
 									 const EIGVTreemapOrientation Orientation)
 {
+	ParentNode.UpdateChildWeightSums();
 	SliceAndDice(ParentNode, 0, ParentNode.Children.Num() - 1, Bounds, Orientation);
 }
 
 void FIGVTreemapLayout::SliceAndDice(FIGVTreemapNode& ParentNode, const FBox2D& Bounds)
 {
+	ParentNode.UpdateChildWeightSums();
 	SliceAndDice(ParentNode, 0, ParentNode.Children.Num() - 1, Bounds);
 }
 
 void FIGVTreemapLayout::SliceAndDice(FIGVTreemapNode& ParentNode,
 									 EIGVTreemapOrientation const Orientation)
 {
+	ParentNode.UpdateChildWeightSums();
 	SliceAndDice(ParentNode, 0, ParentNode.Children.Num() - 1, ParentNode.Rect, Orientation);
 }
 
 void FIGVTreemapLayout::SliceAndDice(FIGVTreemapNode& ParentNode)
 {
+	ParentNode.UpdateChildWeightSums();
 	SliceAndDice(ParentNode, 0, ParentNode.Children.Num() - 1, ParentNode.Rect);
 }
 
+// Every iteration fills the short side of the remaining bounds with a row of children, as long
+// as that brings the aspect ratios closer to 1, and continues in the rest of the bounds. Each
+// child is visited by one row and one SliceAndDice, so a parent takes linear time.
 void FIGVTreemapLayout::Squarified(FIGVTreemapNode& ParentNode, int32 const FirstIdx,
 								   int32 const LastIdx, FBox2D const& Bounds)
 {
-	if (FirstIdx > LastIdx)
-	{
-		return;
-	}
+	int32 RowFirstIdx = FirstIdx;
+	FBox2D RestBounds = Bounds;
 
-	if (LastIdx - FirstIdx < 2)
+	while (RowFirstIdx <= LastIdx)
 	{
-		return SliceAndDice(ParentNode, FirstIdx, LastIdx, Bounds);
-	}
+		if (LastIdx - RowFirstIdx < 2)
+		{
+			SliceAndDice(ParentNode, RowFirstIdx, LastIdx, RestBounds);
+			return;
+		}
 
-	double const AccumWeight = AccumulateWeight(ParentNode, FirstIdx, LastIdx);
+		double const AccumWeight = AccumulateWeight(ParentNode, RowFirstIdx, LastIdx);
 
-	int32 MidIdx = FirstIdx;
-	double const FirstRelativeWeight = ParentNode.Children[FirstIdx]->Weight / AccumWeight;
-	double RelativeWeightOffset = FirstRelativeWeight;
+		int32 MidIdx = RowFirstIdx;
+		double const FirstRelativeWeight = ParentNode.Children[RowFirstIdx]->Weight / AccumWeight;
+		double RelativeWeightOffset = FirstRelativeWeight;
 
-	FVector2D const BoundsSize = Bounds.GetSize();
-	float const X = Bounds.Min.X;
-	float const Y = Bounds.Min.Y;
-	float const W = BoundsSize.X;
-	float const H = BoundsSize.Y;
+		FVector2D const BoundsSize = RestBounds.GetSize();
+		float const X = RestBounds.Min.X;
+		float const Y = RestBounds.Min.Y;
+		float const W = BoundsSize.X;
+		float const H = BoundsSize.Y;
+
+		// Rows along the short side
+		bool const bRowAlongX = W < H;
+		float const Big = bRowAlongX ? H : W;
+		float const Small = bRowAlongX ? W : H;
 
-	if (W < H)
-	{
 		while (MidIdx <= LastIdx)
 		{
 			float const AspectRatio =
-				NormalizedAspectRatio(H, W, FirstRelativeWeight, RelativeWeightOffset);
+				NormalizedAspectRatio(Big, Small, FirstRelativeWeight, RelativeWeightOffset);
 			float const RelativeWeight = ParentNode.Children[MidIdx]->Weight / AccumWeight;
 
-			if (NormalizedAspectRatio(H, W, FirstRelativeWeight,
+			if (NormalizedAspectRatio(Big, Small, FirstRelativeWeight,
 									  RelativeWeightOffset + RelativeWeight) > AspectRatio)
 				break;
 
@@ -212,39 +352,29 @@ void FIGVTreemapLayout::Squarified(FIGVTreemapNode& ParentNode, int32 const Firs
 			RelativeWeightOffset += RelativeWeight;
 		}
 
-		SliceAndDice(ParentNode, FirstIdx, MidIdx,
-					 FBox2D(FVector2D(X, Y), FVector2D(X + W, Y + H * RelativeWeightOffset)));
+		// The row ends with the child that did not improve it, if any
+		int32 const RowLastIdx = FMath::Min(MidIdx, LastIdx);
 
-		FVector2D const NextCornerMin(X, Y + H * RelativeWeightOffset);
-
-		return Squarified(
-			ParentNode, MidIdx + 1, LastIdx,
-			FBox2D(NextCornerMin, NextCornerMin + FVector2D(W, H * (1 - RelativeWeightOffset))));
-	}
-	else
-	{
-		while (MidIdx <= LastIdx)
+		if (bRowAlongX)
 		{
-			float const AspectRatio =
-				NormalizedAspectRatio(W, H, FirstRelativeWeight, RelativeWeightOffset);
-			float const RelativeWeight = ParentNode.Children[MidIdx]->Weight / AccumWeight;
-
-			if (NormalizedAspectRatio(W, H, FirstRelativeWeight,
-									  RelativeWeightOffset + RelativeWeight) > AspectRatio)
-				break;
+			SliceAndDice(ParentNode, RowFirstIdx, RowLastIdx,
+						 FBox2D(FVector2D(X, Y), FVector2D(X + W, Y + H * RelativeWeightOffset)));
 
-			MidIdx++;
-			RelativeWeightOffset += RelativeWeight;
+			FVector2D const NextCornerMin(X, Y + H * RelativeWeightOffset);
+			RestBounds = FBox2D(NextCornerMin,
+								NextCornerMin + FVector2D(W, H * (1 - RelativeWeightOffset)));
 		}
+		else
+		{
+			SliceAndDice(ParentNode, RowFirstIdx, RowLastIdx,
+						 FBox2D(FVector2D(X, Y), FVector2D(X + W * RelativeWeightOffset, Y + H)));
 
-		SliceAndDice(ParentNode, FirstIdx, MidIdx,
-					 FBox2D(FVector2D(X, Y), FVector2D(X + W * RelativeWeightOffset, Y + H)));
-
-		FVector2D const NextCornerMin(X + W * RelativeWeightOffset, Y);
+			FVector2D const NextCornerMin(X + W * RelativeWeightOffset, Y);
+			RestBounds = FBox2D(NextCornerMin,
+								NextCornerMin + FVector2D(W * (1 - RelativeWeightOffset), H));
+		}
 
-		return Squarified(
-			ParentNode, MidIdx + 1, LastIdx,
-			FBox2D(NextCornerMin, NextCornerMin + FVector2D(W * (1 - RelativeWeightOffset), H)));
+		RowFirstIdx = RowLastIdx + 1;
 	}
 }
 
@@ -260,6 +390,7 @@ void FIGVTreemapLayout::Squarified(FIGVTreemapNode& ParentNode, float Nesting)
 	}
 
 	ParentNode.SortChildrenBySize();
+	ParentNode.UpdateChildWeightSums();
 	FVector2D const BoundsSize = ParentNode.Rect.GetSize();
 	Squarified(ParentNode, 0, ParentNode.Children.Num() - 1,
 			   ParentNode.Rect.ExpandBy(FMath::Min(BoundsSize.X, BoundsSize.Y) * -Nesting * 0.5));
@@ -268,6 +399,7 @@ void FIGVTreemapLayout::Squarified(FIGVTreemapNode& ParentNode, float Nesting)
 void FIGVTreemapLayout::Squarified(FIGVTreemapNode& ParentNode)
 {
 	ParentNode.SortChildrenBySize();
+	ParentNode.UpdateChildWeightSums();
 	Squarified(ParentNode, 0, ParentNode.Children.Num() - 1, ParentNode.Rect);
 }
 
@@ -275,13 +407,9 @@ double FIGVTreemapLayout::AccumulateWeight(FIGVTreemapNode& ParentNode, int32 co
 										   int32 const LastIdx)
 {
 	check(LastIdx < ParentNode.Children.Num());
+	check(ParentNode.ChildWeightSums.Num() == ParentNode.Children.Num() + 1);
 
-	double Result = 0;
-	for (int32 Idx = FirstIdx; Idx <= LastIdx; Idx++)
-	{
-		Result += ParentNode.Children[Idx]->Weight;
-	}
-	return Result;
+	return ParentNode.ChildWeightSums[LastIdx + 1] - ParentNode.ChildWeightSums[FirstIdx];
 }
 
 float FIGVTreemapLayout::NormalizedAspectRatio(float const Big, float const Small,
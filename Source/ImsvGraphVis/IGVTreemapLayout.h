@@ -18,6 +18,14 @@ struct IMSVGRAPHVIS_API FIGVTreemapNode
 	FBox2D Rect;
 	float Weight;
 
+	// Draws the weight and position offset of this node only, so that the layout of a subtree
+	// does not depend on the order in which the subtrees are laid out
+	FRandomStream RandomStream;
+
+	// ChildWeightSums[Idx] is the weight of Children[0 .. Idx - 1], so the weight of any range of
+	// children takes two lookups. Set by UpdateChildWeightSums once the children are in order.
+	TArray<double> ChildWeightSums;
+
 	FIGVTreemapNode(struct FIGVCluster* const InCluster);
 
 	template <class FunctionType>
@@ -41,8 +49,10 @@ struct IMSVGRAPHVIS_API FIGVTreemapNode
 	}
 
 	bool IsLeaf() const;
+	void SetRandomWeight();  // Expects the weights of the children
 	void SetRandomWeights();
 	void SortChildrenBySize();
+	void UpdateChildWeightSums();
 };
 
 class IMSVGRAPHVIS_API FIGVTreemapLayout
@@ -58,6 +68,10 @@ public:
 
 	void Compute();
 
+	// Lays out the given subtree again inside the rectangle it was assigned by the last layout.
+	// Positions are left unnormalized, like Compute().
+	void ComputeSubtree(struct FIGVCluster& SubtreeRoot);
+
 public:
 	static void SliceAndDice(FIGVTreemapNode& ParentNode, int32 const FirstIdx, int32 const LastIdx,
 							 FBox2D const& Bounds, EIGVTreemapOrientation const Orientation);
@@ -69,6 +83,7 @@ public:
 	static void SliceAndDice(FIGVTreemapNode& ParentNode, EIGVTreemapOrientation const Orientation);
 	static void SliceAndDice(FIGVTreemapNode& ParentNode);
 
+	// The overloads with child ranges expect the parent's ChildWeightSums to be up to date
 	static void Squarified(FIGVTreemapNode& ParentNode, int32 const FirstIdx, int32 const LastIdx,
 						   FBox2D const& Bounds);
 	static void Squarified(FIGVTreemapNode& ParentNode, float Nesting);
@@ -76,6 +91,12 @@ public:
 
 protected:
 	void SetupTreemapNodes();
+	void SetupTreemapNodes(struct FIGVCluster& SubtreeRoot);
+
+	void ComputeRects();
+
+	// Lays out the nodes above a frontier of subtrees serially, and the subtrees concurrently
+	void ComputeRectsParallel(float const Nesting);
 
 	static double AccumulateWeight(FIGVTreemapNode& ParentNode, int32 const FirstIdx,
 								   int32 const LastIdx);
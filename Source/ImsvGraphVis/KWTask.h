@@ -35,3 +35,124 @@ struct FKWTask
 		return TGraphTask<FKWTask>::CreateTask().ConstructAndDispatchWhenReady(FKWTask{F});
 	}
 };
+
+// Chunks of at least MinChunkSize elements, several per thread so that they balance
+FORCEINLINE int32 GetKWParallelChunkSize(int32 const Num, int32 const MinChunkSize)
+{
+	int32 const NumThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	return FMath::Max3(1, MinChunkSize, FMath::DivideAndRoundUp(Num, 8 * NumThreads));
+}
+
+// Runs Function(ChunkIdx, Begin, End) for the chunks of [0, Num) and waits. Tasks and the calling
+// thread take the next chunk from a shared counter, so threads that finish early take over the
+// remaining chunks of the others, and there is one task per thread rather than per element.
+template <typename FunctionType>
+void KWParallelForChunks(int32 const Num, int32 const ChunkSize, FunctionType const& Function)
+{
+	int32 const NumChunks = Num > 0 ? FMath::DivideAndRoundUp(Num, ChunkSize) : 0;
+	if (NumChunks <= 1 || !FApp::ShouldUseThreadingForPerformance())
+	{
+		for (int32 ChunkIdx = 0; ChunkIdx < NumChunks; ChunkIdx++)
+		{
+			int32 const Begin = ChunkIdx * ChunkSize;
+			Function(ChunkIdx, Begin, FMath::Min(Begin + ChunkSize, Num));
+		}
+		return;
+	}
+
+	FThreadSafeCounter NextChunkIdx;
+	auto const RunChunks = [&]() {
+		for (int32 ChunkIdx = NextChunkIdx.Increment() - 1; ChunkIdx < NumChunks;
+			 ChunkIdx = NextChunkIdx.Increment() - 1)
+		{
+			int32 const Begin = ChunkIdx * ChunkSize;
+			Function(ChunkIdx, Begin, FMath::Min(Begin + ChunkSize, Num));
+		}
+	};
+
+	int32 const NumTasks =
+		FMath::Min(NumChunks, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) - 1;
+	FGraphEventArray Tasks;
+	for (int32 TaskIdx = 0; TaskIdx < NumTasks; TaskIdx++)
+	{
+		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&RunChunks]() { RunChunks(); }));
+	}
+	RunChunks();
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+}
+
+// Runs Function(Begin, End) over consecutive ranges of [0, Num) and waits. MinChunkSize keeps the
+// ranges large enough to outweigh the scheduling when the work per element is small.
+template <typename FunctionType>
+void KWParallelFor(int32 const Num, FunctionType const& Function, int32 const MinChunkSize = 1)
+{
+	KWParallelForChunks(Num, GetKWParallelChunkSize(Num, MinChunkSize),
+						[&Function](int32 const ChunkIdx, int32 const Begin, int32 const End) {
+							Function(Begin, End);
+						});
+}
+
+// Reduce of Map(Begin, End) over the ranges of [0, Num). The partial results are reduced in order,
+// so the result does not depend on the scheduling even if Reduce is not commutative.
+template <typename ResultType, typename MapType, typename ReduceType>
+ResultType KWParallelReduce(int32 const Num, ResultType const& Identity, MapType const& Map,
+							ReduceType const& Reduce, int32 const MinChunkSize = 1)
+{
+	int32 const ChunkSize = GetKWParallelChunkSize(Num, MinChunkSize);
+	TArray<ResultType, TInlineAllocator<64>> Partials;
+	Partials.Init(Identity, Num > 0 ? FMath::DivideAndRoundUp(Num, ChunkSize) : 0);
+
+	KWParallelForChunks(Num, ChunkSize,
+						[&](int32 const ChunkIdx, int32 const Begin, int32 const End) {
+							Partials[ChunkIdx] = Map(Begin, End);
+						});
+
+	ResultType Result = Identity;
+	for (ResultType const& Partial : Partials)
+	{
+		Result = Reduce(Result, Partial);
+	}
+	return Result;
+}
+
+// Exclusive prefix sum: Write(Idx, Sum) with the sum of Read over [0, Idx), for every Idx of
+// [0, Num). One pass sums the chunks, the next writes them from the offsets of the chunks.
+// Returns the total.
+template <typename ValueType, typename ReadType, typename WriteType>
+ValueType KWParallelPrefixSum(int32 const Num, ReadType const& Read, WriteType const& Write,
+							  int32 const MinChunkSize = 1024)
+{
+	int32 const ChunkSize = GetKWParallelChunkSize(Num, MinChunkSize);
+	TArray<ValueType, TInlineAllocator<64>> ChunkOffsets;
+	ChunkOffsets.Init(ValueType(), Num > 0 ? FMath::DivideAndRoundUp(Num, ChunkSize) : 0);
+
+	KWParallelForChunks(Num, ChunkSize,
+						[&](int32 const ChunkIdx, int32 const Begin, int32 const End) {
+							ValueType Sum = ValueType();
+							for (int32 Idx = Begin; Idx < End; Idx++)
+							{
+								Sum += Read(Idx);
+							}
+							ChunkOffsets[ChunkIdx] = Sum;
+						});
+
+	ValueType Total = ValueType();
+	for (ValueType& Offset : ChunkOffsets)
+	{
+		ValueType const Sum = Offset;
+		Offset = Total;
+		Total += Sum;
+	}
+
+	KWParallelForChunks(Num, ChunkSize,
+						[&](int32 const ChunkIdx, int32 const Begin, int32 const End) {
+							ValueType Sum = ChunkOffsets[ChunkIdx];
+							for (int32 Idx = Begin; Idx < End; Idx++)
+							{
+								ValueType const Value = Read(Idx);
+								Write(Idx, Sum);
+								Sum += Value;
+							}
+						});
+	return Total;
+}